@@ -0,0 +1,97 @@
+#include "AssetLoader.h"
+
+#include <iostream>
+
+#include "RolloutRunner.h"
+
+// --- lookup ---
+
+bool loadImage(const AssetPack* pack, const std::string& name, sf::Image& out) {
+    AssetView v;
+    if (pack && pack->find(name, v)) {
+        if (v.kind == AssetRgba) { out.create(unsigned(v.width), unsigned(v.height), v.data); return true; }
+        if (out.loadFromMemory(v.data, v.size)) return true;
+    }
+    return out.loadFromFile(name);
+}
+
+bool loadTexture(const AssetPack* pack, const std::string& name, sf::Texture& out) {
+    AssetView v;
+    if (pack && pack->find(name, v)) {
+        if (v.kind == AssetRgba) {
+            if (out.create(unsigned(v.width), unsigned(v.height))) { out.update(v.data); return true; }
+        }
+        else if (out.loadFromMemory(v.data, v.size)) {
+            return true;
+        }
+    }
+    return out.loadFromFile(name);
+}
+
+bool loadFont(const AssetPack* pack, const std::string& name, sf::Font& out) {
+    AssetView v;
+    if (pack && pack->find(name, v) && v.kind == AssetRaw && out.loadFromMemory(v.data, v.size)) return true;
+    return out.loadFromFile(name);
+}
+
+bool openMusic(const AssetPack* pack, const std::string& name, sf::Music& out) {
+    AssetView v;
+    if (pack && pack->find(name, v) && v.kind == AssetRaw && out.openFromMemory(v.data, v.size)) return true;
+    return out.openFromFile(name);
+}
+
+bool loadSoundBuffer(const AssetPack* pack, const std::string& name, sf::SoundBuffer& out) {
+    AssetView v;
+    if (pack && pack->find(name, v) && v.kind == AssetRaw && out.loadFromMemory(v.data, v.size)) return true;
+    return out.loadFromFile(name);
+}
+
+// --- background decoding ---
+
+AssetLoader::AssetLoader(const AssetPack* pack_, int threads_) : pack(pack_), threads(threads_) {}
+
+AssetLoader::~AssetLoader() {
+    if (runner.joinable()) runner.join();
+}
+
+void AssetLoader::start(std::vector<std::string> names, std::vector<std::function<void()>> jobs) {
+    remaining = int(names.size() + jobs.size());
+    // parallelFor blocks until the batch is done, so it runs on a thread of its own;
+    // the pool is local to that thread and its workers exit with the batch
+    runner = std::thread([this, names = std::move(names), jobs = std::move(jobs)] {
+        {
+            WorkStealingPool pool(threads);
+            pool.parallelFor(std::int64_t(names.size() + jobs.size()), [&](std::int64_t i, int) {
+                if (std::size_t(i) >= names.size()) {
+                    jobs[std::size_t(i) - names.size()]();
+                    --remaining;
+                    return;
+                }
+                LoadedImage img;
+                img.name = names[std::size_t(i)];
+                img.ok = loadImage(pack, img.name, img.image);
+                if (!img.ok) std::cerr << img.name << " load fail\n";
+                {
+                    std::lock_guard<std::mutex> lk(readyLock);
+                    ready.push_back(std::move(img));
+                }
+                --remaining;
+            }, 1);
+        }
+        runnerDone = true;
+    });
+}
+
+std::vector<LoadedImage> AssetLoader::takeReady() {
+    // reap the runner once it has finished, so no loader thread outlives the batch
+    if (runnerDone && runner.joinable()) runner.join();
+    std::vector<LoadedImage> out;
+    std::lock_guard<std::mutex> lk(readyLock);
+    out.swap(ready);
+    return out;
+}
+
+std::vector<LoadedImage> AssetLoader::takeAll() {
+    if (runner.joinable()) runner.join();
+    return takeReady();
+}
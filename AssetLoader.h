@@ -0,0 +1,66 @@
+#pragma once
+
+// Asset lookup (the asset pack first, loose files second) and background image
+// decoding. AssetLoader decodes a list of images, plus any other loading jobs, on a
+// WorkStealingPool from a thread of its own, so the caller keeps drawing frames; the
+// render thread collects the finished images with takeReady() and uploads them
+// itself, since GL work has to stay on that thread. The pool only lives for the
+// one batch: once it is done no loader thread is left running.
+
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "AssetPack.h"
+
+// Each looks `name` ("images/wall.png") up in `pack` (may be null) and falls back to
+// the loose file. Pack payloads stay in the mapping, so fonts and music read from
+// it for as long as they are open.
+bool loadImage(const AssetPack* pack, const std::string& name, sf::Image& out);
+bool loadTexture(const AssetPack* pack, const std::string& name, sf::Texture& out);
+bool loadFont(const AssetPack* pack, const std::string& name, sf::Font& out);
+bool openMusic(const AssetPack* pack, const std::string& name, sf::Music& out);
+bool loadSoundBuffer(const AssetPack* pack, const std::string& name, sf::SoundBuffer& out);
+
+struct LoadedImage {
+    std::string name;
+    sf::Image image;
+    bool ok = false;
+};
+
+class AssetLoader {
+public:
+    explicit AssetLoader(const AssetPack* pack, int threads = 0);
+    ~AssetLoader();   // waits for decodes still running
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // Starts decoding `names` and running `jobs` (which must not touch GL) in the
+    // background. Call once.
+    void start(std::vector<std::string> names, std::vector<std::function<void()>> jobs = {});
+
+    // Images finished since the last call, in completion order.
+    std::vector<LoadedImage> takeReady();
+    // Like takeReady(), but first blocks until every image and job is done.
+    std::vector<LoadedImage> takeAll();
+
+    bool finished() const { return remaining.load() == 0; }
+
+private:
+    const AssetPack* pack;
+    int threads;
+    std::thread runner;
+    std::atomic<bool> runnerDone{ false };   // pool torn down, runner about to exit
+
+    std::mutex readyLock;
+    std::vector<LoadedImage> ready;
+    std::atomic<int> remaining{ 0 };
+};
@@ -0,0 +1,121 @@
+#include "AssetPack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+// File layout, all little-endian:
+//   "SNKP" u32 version, u32 entry count, u32 reserved
+//   entry count x 80-byte entries, sorted by name:
+//     char name[48] (NUL-padded), u32 kind, u32 width, u32 height, u32 reserved,
+//     u64 offset (from the start of the file), u64 size
+//   payloads, each starting on a 16-byte boundary
+static const char PACK_MAGIC[4] = { 'S', 'N', 'K', 'P' };
+static constexpr std::uint32_t PACK_VERSION = 1;
+static constexpr std::size_t PACK_HEADER_SIZE = 16;
+static constexpr std::size_t PACK_ENTRY_SIZE = 80;
+static constexpr std::size_t PACK_ALIGN = 16;
+
+static void putLE(std::vector<std::uint8_t>& out, std::uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(std::uint8_t(v >> (8 * i)));
+}
+
+static std::uint64_t getLE(const std::uint8_t* p, int bytes) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= std::uint64_t(p[i]) << (8 * i);
+    return v;
+}
+
+// --- reading ---
+
+AssetPack::AssetPack(const std::string& path) : file(path, false) {
+    const std::uint8_t* p = file.data();
+    const std::size_t size = file.size();
+    if (!p || size < PACK_HEADER_SIZE) return;
+    if (std::memcmp(p, PACK_MAGIC, 4) != 0 || getLE(p + 4, 4) != PACK_VERSION) return;
+    const std::uint64_t n = getLE(p + 8, 4);
+    if (n == 0 || n > (size - PACK_HEADER_SIZE) / PACK_ENTRY_SIZE) return;
+
+    // check every entry once here, so find() can trust them
+    const std::uint8_t* idx = p + PACK_HEADER_SIZE;
+    for (std::uint64_t i = 0; i < n; ++i) {
+        const std::uint8_t* e = idx + i * PACK_ENTRY_SIZE;
+        const std::uint64_t off = getLE(e + 64, 8), len = getLE(e + 72, 8);
+        if (e[ASSET_NAME_MAX] != 0 || off > size || len > size - off) return;
+        const std::uint64_t w = getLE(e + 52, 4), h = getLE(e + 56, 4);
+        if (getLE(e + 48, 4) == AssetRgba && (w > 65536 || h > 65536 || w * h * 4 != len)) return;
+    }
+    index = idx;
+    count = int(n);
+}
+
+bool AssetPack::find(const std::string& name, AssetView& out) const {
+    if (name.size() > ASSET_NAME_MAX) return false;
+    int lo = 0, hi = count;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        const std::uint8_t* e = index + std::size_t(mid) * PACK_ENTRY_SIZE;
+        const int c = std::strcmp(reinterpret_cast<const char*>(e), name.c_str());
+        if (c < 0) { lo = mid + 1; continue; }
+        if (c > 0) { hi = mid; continue; }
+        out.kind = AssetKind(getLE(e + 48, 4));
+        out.width = int(getLE(e + 52, 4));
+        out.height = int(getLE(e + 56, 4));
+        out.data = file.data() + getLE(e + 64, 8);
+        out.size = std::size_t(getLE(e + 72, 8));
+        return true;
+    }
+    return false;
+}
+
+// --- writing ---
+
+bool AssetPackWriter::add(const std::string& name, AssetKind kind, int width, int height,
+    std::vector<std::uint8_t> bytes) {
+    if (name.empty() || name.size() > ASSET_NAME_MAX) return false;
+    for (const Pending& p : items) if (p.name == name) return false;
+    items.push_back({ name, kind, width, height, std::move(bytes) });
+    return true;
+}
+
+bool AssetPackWriter::save(const std::string& path) const {
+    std::vector<const Pending*> sorted;
+    for (const Pending& p : items) sorted.push_back(&p);
+    std::sort(sorted.begin(), sorted.end(), [](const Pending* a, const Pending* b) {
+        return std::strcmp(a->name.c_str(), b->name.c_str()) < 0;
+    });
+
+    auto align = [](std::uint64_t v) { return (v + PACK_ALIGN - 1) & ~std::uint64_t(PACK_ALIGN - 1); };
+
+    std::vector<std::uint8_t> head;
+    for (char c : PACK_MAGIC) head.push_back(std::uint8_t(c));
+    putLE(head, PACK_VERSION, 4);
+    putLE(head, sorted.size(), 4);
+    putLE(head, 0, 4);
+
+    std::uint64_t offset = align(PACK_HEADER_SIZE + sorted.size() * PACK_ENTRY_SIZE);
+    for (const Pending* p : sorted) {
+        char name[ASSET_NAME_MAX + 1] = {};
+        std::memcpy(name, p->name.data(), p->name.size());
+        head.insert(head.end(), name, name + sizeof(name));
+        putLE(head, p->kind, 4);
+        putLE(head, std::uint32_t(p->width), 4);
+        putLE(head, std::uint32_t(p->height), 4);
+        putLE(head, 0, 4);
+        putLE(head, offset, 8);
+        putLE(head, p->bytes.size(), 8);
+        offset = align(offset + p->bytes.size());
+    }
+
+    std::ofstream f(path, std::ios::binary);
+    f.write(reinterpret_cast<const char*>(head.data()), std::streamsize(head.size()));
+    std::uint64_t at = head.size();
+    static const char zeros[PACK_ALIGN] = {};
+    for (const Pending* p : sorted) {
+        f.write(zeros, std::streamsize(align(at) - at));
+        at = align(at);
+        f.write(reinterpret_cast<const char*>(p->bytes.data()), std::streamsize(p->bytes.size()));
+        at += p->bytes.size();
+    }
+    return bool(f);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+// Asset pack: every file the game loads in one archive, read through a memory map.
+// A fixed header is followed by a name-sorted index of fixed-size entries, so a
+// lookup is a binary search over the mapped index with nothing parsed or copied at
+// open. Payloads are either the original file bytes (OGG, TTF) or images already
+// decoded and shrunk to the size they are drawn at (tightly packed RGBA8), so the
+// game skips PNG decoding entirely. Music streams straight out of the mapping.
+//
+// Built by AssetPacker.cpp from the audios/, fonts/ and images/ folders. Plain C++;
+// SnakeGame.cpp turns entries into SFML objects.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+enum AssetKind : std::uint32_t {
+    AssetRaw = 0,    // the file as it was on disk
+    AssetRgba = 1,   // width x height RGBA8 pixels
+};
+
+constexpr std::size_t ASSET_NAME_MAX = 47;   // bytes, without the terminator
+
+struct AssetView {
+    AssetKind kind = AssetRaw;
+    int width = 0;    // AssetRgba only
+    int height = 0;
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+};
+
+class AssetPack {
+public:
+    // Maps `path`; valid() is false if it is missing or not a pack.
+    explicit AssetPack(const std::string& path);
+
+    bool valid() const { return count > 0; }
+    int size() const { return count; }
+
+    // Looks `name` ("images/wall.png") up; false if the pack does not have it.
+    bool find(const std::string& name, AssetView& out) const;
+
+private:
+    MappedFile file;
+    const std::uint8_t* index = nullptr;
+    int count = 0;
+};
+
+// Collects payloads and writes a pack in one go (the packer tool).
+class AssetPackWriter {
+public:
+    // Names longer than ASSET_NAME_MAX or added twice are rejected.
+    bool add(const std::string& name, AssetKind kind, int width, int height, std::vector<std::uint8_t> bytes);
+    bool save(const std::string& path) const;
+
+private:
+    struct Pending {
+        std::string name;
+        AssetKind kind;
+        int width, height;
+        std::vector<std::uint8_t> bytes;
+    };
+    std::vector<Pending> items;
+};
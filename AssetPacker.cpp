@@ -0,0 +1,123 @@
+// Builds the asset pack (AssetPack.h) the game loads instead of loose files.
+// Build: g++ -O2 -std=c++17 AssetPacker.cpp AssetPack.cpp MappedFile.cpp TextureAtlas.cpp -o AssetPacker -lsfml-graphics -lsfml-system
+// (a command-line tool like SnakeHeadless, so not part of SnakeGame.vcxproj)
+//
+//   ./AssetPacker [asset root] [output]      defaults: . assets.pak
+//
+// Packs every file under audios/, fonts/ and images/. Images the game draws at a
+// known size are decoded and stored shrunk to that size as raw RGBA; any other file
+// is stored byte for byte.
+
+#include <SFML/Graphics.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "AssetPack.h"
+#include "TextureAtlas.h"
+
+namespace fs = std::filesystem;
+
+// On-screen sizes, in step with SnakeGame.cpp (CELL_SIZE 16, MARGIN 32, 40x30 board).
+constexpr int CELL = 16;
+constexpr int SCREEN_W = 40 * CELL;
+constexpr int SCREEN_H = 30 * CELL + 32;
+
+struct ImageRule {
+    const char* name;
+    int w, h;            // per frame
+    int cols, rows;      // frames in the sheet
+};
+
+static const ImageRule IMAGE_RULES[] = {
+    { "images/menu_bg.png", SCREEN_W, SCREEN_H, 1, 1 },
+    { "images/level1_bg.png", SCREEN_W, SCREEN_H, 1, 1 },
+    { "images/level2_bg.png", SCREEN_W, SCREEN_H, 1, 1 },
+    { "images/level3_bg.png", SCREEN_W, SCREEN_H, 1, 1 },
+    { "images/gameover_bg.png", SCREEN_W, SCREEN_H, 1, 1 },
+    { "images/wall.png", CELL, CELL, 1, 1 },
+    { "images/Apple.png", CELL - 4, CELL - 4, 1, 1 },
+    { "images/Bonus.png", CELL - 4, CELL - 4, 1, 1 },
+    { "images/bad.png", CELL - 4, CELL - 4, 1, 1 },
+    { "images/enemy.png", CELL, CELL, 7, 3 },
+};
+
+static const ImageRule* ruleFor(const std::string& name) {
+    for (const ImageRule& r : IMAGE_RULES)
+        if (name == r.name) return &r;
+    return nullptr;
+}
+
+// Decodes `path` and shrinks each frame of the sheet on its own, so neighbouring
+// frames never bleed into each other.
+static bool shrinkImage(const std::string& path, const ImageRule& r, std::vector<std::uint8_t>& out) {
+    sf::Image img;
+    if (!img.loadFromFile(path)) return false;
+    const int fw = int(img.getSize().x) / r.cols, fh = int(img.getSize().y) / r.rows;
+    const int outW = r.w * r.cols;
+    out.assign(std::size_t(outW) * std::size_t(r.h * r.rows) * 4, 0);
+    std::vector<std::uint8_t> frame(std::size_t(r.w) * std::size_t(r.h) * 4);
+    for (int fy = 0; fy < r.rows; ++fy) {
+        for (int fx = 0; fx < r.cols; ++fx) {
+            const sf::Uint8* src = img.getPixelsPtr() + (std::size_t(fy * fh) * img.getSize().x + std::size_t(fx * fw)) * 4;
+            boxDownsample(src, int(img.getSize().x), fw, fh, frame.data(), r.w, r.h);
+            for (int y = 0; y < r.h; ++y) {
+                std::copy_n(&frame[std::size_t(y) * std::size_t(r.w) * 4], std::size_t(r.w) * 4,
+                    &out[(std::size_t(fy * r.h + y) * std::size_t(outW) + std::size_t(fx * r.w)) * 4]);
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const fs::path root = argc > 1 ? argv[1] : ".";
+    const std::string output = argc > 2 ? argv[2] : "assets.pak";
+
+    AssetPackWriter pack;
+    int files = 0;
+    std::uint64_t rawBytes = 0;
+    for (const char* dir : { "audios", "fonts", "images" }) {
+        std::error_code ec;
+        for (const auto& e : fs::recursive_directory_iterator(root / dir, ec)) {
+            if (!e.is_regular_file()) continue;
+            const std::string name = fs::relative(e.path(), root).generic_string();
+            const std::string path = e.path().string();
+
+            bool ok;
+            if (const ImageRule* r = ruleFor(name)) {
+                std::vector<std::uint8_t> pixels;
+                ok = shrinkImage(path, *r, pixels)
+                    && pack.add(name, AssetRgba, r->w * r->cols, r->h * r->rows, std::move(pixels));
+            }
+            else {
+                std::ifstream f(path, std::ios::binary);
+                std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+                ok = f.is_open() && pack.add(name, AssetRaw, 0, 0, std::move(bytes));
+            }
+            if (!ok) {
+                std::fprintf(stderr, "%s: cannot pack\n", name.c_str());
+                return 1;
+            }
+            rawBytes += std::uint64_t(e.file_size());
+            ++files;
+        }
+        if (ec) std::fprintf(stderr, "%s: %s\n", (root / dir).string().c_str(), ec.message().c_str());
+    }
+    if (files == 0) {
+        std::fprintf(stderr, "no assets under %s\n", root.string().c_str());
+        return 1;
+    }
+    if (!pack.save(output)) {
+        std::fprintf(stderr, "%s: cannot write\n", output.c_str());
+        return 1;
+    }
+    std::printf("%d files (%.1f MB loose) -> %s (%.1f MB)\n", files, rawBytes / 1048576.0,
+        output.c_str(), double(fs::file_size(output)) / 1048576.0);
+    return 0;
+}
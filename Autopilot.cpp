@@ -0,0 +1,248 @@
+#include "Autopilot.h"
+
+#include <algorithm>
+
+// per Direction, as cell index offsets
+static constexpr int STEP[4] = { -WIDTH, WIDTH, -1, 1 };
+
+// past this many changed cells a rebuild is cheaper than repairing cell by cell
+static constexpr int REPAIR_LIMIT = 32;
+
+static const Plane PLAYFIELD = rectPlane(1, WIDTH - 2, 1, HEIGHT - 2);
+
+// --- distance field ---
+
+void DistanceField::rebuild(const Plane& blocked_, const Plane& targets_) {
+    blocked = blocked_;
+    targets = targets_;
+    dist.fill(UNREACHABLE);
+
+    int queued = 0;
+    targets.without(blocked).forEach([&](int i) {
+        dist[i] = 0;
+        queue[queued++] = std::uint16_t(i);
+    });
+    spread(queued);
+}
+
+bool DistanceField::supported(int cell) const {
+    if (targets.test(cell)) return true;
+    const int want = dist[cell] - 1;
+    for (int off : STEP) {
+        int n = cell + off;
+        if (!blocked.test(n) && dist[n] == want) return true;
+    }
+    return false;
+}
+
+void DistanceField::spread(int queued) {
+    // queue entries are popped in order of distance, so each cell is settled once
+    for (int head = 0; head < queued; ++head) {
+        const int u = queue[head];
+        const std::int16_t du = std::int16_t(dist[u] + 1);
+        for (int off : STEP) {
+            int v = u + off;
+            if (dist[v] > du && !blocked.test(v)) {
+                dist[v] = du;
+                queue[queued++] = std::uint16_t(v);
+            }
+        }
+    }
+}
+
+void DistanceField::unblock(int cell) {
+    if (!blocked.test(cell)) return;
+    blocked.reset(cell);
+
+    int d = UNREACHABLE;
+    if (targets.test(cell)) {
+        d = 0;
+    }
+    else {
+        for (int off : STEP) {
+            int n = cell + off;
+            if (!blocked.test(n)) d = std::min(d, dist[n] + 1);
+        }
+    }
+    if (d >= UNREACHABLE) return;
+
+    // distances can only shrink, and only through this cell
+    dist[cell] = std::int16_t(d);
+    queue[0] = std::uint16_t(cell);
+    spread(1);
+}
+
+void DistanceField::block(int cell) {
+    if (blocked.test(cell)) return;
+    blocked.set(cell);
+    const int old = dist[cell];
+    dist[cell] = UNREACHABLE;
+    if (old == UNREACHABLE) return;
+
+    // 1. Every cell whose shortest paths all ran through `cell` loses its distance.
+    //    A cell is re-checked each time one of its parents is lost.
+    int nLost = 0;
+    lost[nLost++] = std::uint32_t(cell) | std::uint32_t(old) << 16;
+    for (int k = 0; k < nLost; ++k) {
+        const int u = int(lost[k] & 0xFFFF);
+        const int child = int(lost[k] >> 16) + 1;
+        for (int off : STEP) {
+            int v = u + off;
+            if (dist[v] != child || blocked.test(v) || supported(v)) continue;
+            lost[nLost++] = std::uint32_t(v) | std::uint32_t(child) << 16;
+            dist[v] = UNREACHABLE;
+        }
+    }
+
+    // 2. Re-grow the lost region from its intact border, nearest border cells first.
+    int nSeeds = 0;
+    for (int k = 0; k < nLost; ++k) {
+        const int u = int(lost[k] & 0xFFFF);
+        for (int off : STEP) {
+            int n = u + off;
+            if (dist[n] != UNREACHABLE && !blocked.test(n)) seeds[nSeeds++] = std::uint16_t(n);
+        }
+    }
+    std::sort(seeds.begin(), seeds.begin() + nSeeds,
+        [&](std::uint16_t a, std::uint16_t b) { return dist[a] < dist[b]; });
+
+    // merge the sorted seeds with the BFS queue so cells still settle in distance order
+    int queued = 0, qHead = 0, sHead = 0;
+    while (qHead < queued || sHead < nSeeds) {
+        int u;
+        if (sHead < nSeeds && (qHead == queued || dist[seeds[sHead]] <= dist[queue[qHead]])) u = seeds[sHead++];
+        else u = queue[qHead++];
+
+        const std::int16_t du = std::int16_t(dist[u] + 1);
+        for (int off : STEP) {
+            int v = u + off;
+            if (dist[v] > du && !blocked.test(v)) {
+                dist[v] = du;
+                queue[queued++] = std::uint16_t(v);
+            }
+        }
+    }
+}
+
+// --- autopilot ---
+
+void Autopilot::sync(const SnakeSim& sim) {
+    Plane blocked = sim.plane(CellSnake) | sim.plane(CellObstacle) | sim.plane(CellEnemy)
+        | sim.plane(CellOuterWall) | sim.plane(CellInnerWall) | sim.plane(CellShrinkFood);
+    Plane targets = sim.plane(CellFood);
+    if (sim.bonusActive) targets |= sim.plane(CellBonus);
+
+    if (!synced || targets != foodField.targetCells()) {
+        foodField.rebuild(blocked, targets);
+        synced = true;
+        return;
+    }
+
+    // usually just the new head and the old tail, plus an enemy step on level 3
+    Plane added = blocked.without(foodField.blockedCells());
+    Plane removed = foodField.blockedCells().without(blocked);
+    if (added.count() + removed.count() > REPAIR_LIMIT) {
+        foodField.rebuild(blocked, targets);
+        return;
+    }
+    removed.forEach([&](int i) { foodField.unblock(i); });
+    added.forEach([&](int i) { foodField.block(i); });
+}
+
+int Autopilot::room(int from, int tail, int need) const {
+    Plane passable = PLAYFIELD.without(foodField.blockedCells());
+    if (tail >= 0) passable.set(tail);   // the tail moves on as the head does
+    passable.reset(from);
+
+    Plane seen, frontier;
+    seen.set(from);
+    frontier.set(from);
+    int n = 0;
+    while (n < need) {
+        Plane grow = (frontier.shl(1) | frontier.shr(1) | frontier.shl(WIDTH) | frontier.shr(WIDTH)) & passable;
+        grow = grow.without(seen);
+        if (!grow.any()) break;
+        if (tail >= 0 && grow.test(tail)) return need;
+        n += grow.count();
+        seen |= grow;
+        frontier = grow;
+    }
+    return std::min(n, need);
+}
+
+Direction Autopilot::decide(const SnakeSim& sim) {
+    sync(sim);
+
+    const Plane& blocked = foodField.blockedCells();
+    const int head = cellIndex(sim.snake.front());
+    const int tail = cellIndex(sim.snake.back());
+    const int length = sim.snake.size();
+
+    // cells an enemy could step onto this tick, and cells the coming shrink cuts off
+    Plane danger;
+    if (sim.level == 3) {
+        const Plane& e = sim.plane(CellEnemy);
+        danger = e.shl(1) | e.shr(1) | e.shl(WIDTH) | e.shr(WIDTH);
+        if (sim.warningActive) {
+            const int s = sim.shrinkTicks + 3;
+            danger |= PLAYFIELD.without(rectPlane(s, WIDTH - 1 - s, s, HEIGHT - 1 - s));
+        }
+    }
+
+    struct Move {
+        Direction dir;
+        int cell;
+        int dist;
+        bool risky;
+    };
+    Move moves[3];
+    int n = 0;
+    for (int d = 0; d < 4; ++d) {
+        if (d == (sim.dir ^ 1)) continue;
+        int c = head + STEP[d];
+        if (blocked.test(c)) continue;
+        moves[n++] = { Direction(d), c, foodField.at(c), danger.test(c) };
+    }
+    if (n == 0) return sim.dir;   // boxed in
+
+    // safe cells first, then nearest to food (at most three, so insertion order)
+    auto before = [](const Move& a, const Move& b) { return a.risky != b.risky ? !a.risky : a.dist < b.dist; };
+    for (int k = 1; k < n; ++k) {
+        for (int j = k; j > 0 && before(moves[j], moves[j - 1]); --j) std::swap(moves[j], moves[j - 1]);
+    }
+
+    // shortest way to food that still leaves room for the body
+    for (int k = 0; k < n; ++k) {
+        if (moves[k].dist == DistanceField::UNREACHABLE) continue;
+        if (room(moves[k].cell, tail, length) >= length) return moves[k].dir;
+    }
+
+    // otherwise stall: follow the tail the long way round
+    ++fallbackCount;
+    Plane toTail = blocked;
+    toTail.reset(tail);
+    Plane tailCell;
+    tailCell.set(tail);
+    tailField.rebuild(toTail, tailCell);
+
+    const Move* best = nullptr;
+    for (int k = 0; k < n; ++k) {
+        const Move& m = moves[k];
+        if (tailField.at(m.cell) == DistanceField::UNREACHABLE) continue;
+        if (!best || (best->risky && !m.risky) ||
+            (best->risky == m.risky && tailField.at(m.cell) > tailField.at(best->cell)))
+            best = &m;
+    }
+    if (best) return best->dir;
+
+    // the tail is cut off too: take the biggest pocket
+    int bestRoom = -1;
+    for (int k = 0; k < n; ++k) {
+        int r = room(moves[k].cell, -1, WIDTH * HEIGHT);
+        if (r > bestRoom) {
+            bestRoom = r;
+            best = &moves[k];
+        }
+    }
+    return best->dir;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// Built-in bot. It steers along a BFS distance field to the food (and the bonus
+// while it is up), treating walls, obstacles, enemies, shrink food and the body as
+// blocked. Between decisions only a few cells change (the new head, the old tail,
+// an enemy step), so the field is repaired from the cells that differ instead of
+// being rebuilt; a decision is then a few neighbour lookups plus a bitboard flood
+// fill that checks the move does not seal the snake in. When no food move is safe
+// it chases its own tail to buy time.
+
+#include "SnakeSim.h"
+
+#include <array>
+#include <cstdint>
+
+// BFS distances from a set of target cells over every cell not in `blocked`.
+// Cells on the outer border must stay blocked (neighbours are index offsets).
+class DistanceField {
+public:
+    static constexpr std::int16_t UNREACHABLE = INT16_MAX;
+
+    void rebuild(const Plane& blocked, const Plane& targets);
+    // One cell became blocked / free; distances are exact again afterwards.
+    void block(int cell);
+    void unblock(int cell);
+
+    int at(int cell) const { return dist[cell]; }
+    const Plane& blockedCells() const { return blocked; }
+    const Plane& targetCells() const { return targets; }
+
+private:
+    static constexpr int N = WIDTH * HEIGHT;
+
+    bool supported(int cell) const;
+    // BFS from `queued` cells already in `queue`, each with a final distance.
+    void spread(int queued);
+
+    std::array<std::int16_t, N> dist{};
+    Plane blocked;
+    Plane targets;
+
+    // scratch for block()/unblock(); sized so no update ever allocates
+    std::array<std::uint32_t, N> lost{};     // cell | old distance << 16
+    std::array<std::uint16_t, N> queue{};
+    std::array<std::uint16_t, 4 * N> seeds{};
+};
+
+class Autopilot {
+public:
+    // Drops the cached field; call when the next decision is for a different game.
+    void reset() { synced = false; }
+
+    // Heading for the next step of `sim`.
+    Direction decide(const SnakeSim& sim);
+
+    // Decisions that had to fall back to tail chasing (or to the roomiest move).
+    long long fallbacks() const { return fallbackCount; }
+
+private:
+    void sync(const SnakeSim& sim);
+    // Free cells reachable from `from` once the head is there, counting stops at `need`.
+    int room(int from, int tail, int need) const;
+
+    DistanceField foodField;   // to the food and bonus, repaired every decision
+    DistanceField tailField;   // to the tail, built only when falling back
+    bool synced = false;
+    long long fallbackCount = 0;
+};
@@ -0,0 +1,181 @@
+#pragma once
+
+// Fixed-size bit set with one bit per board cell (bit i = cell index i). The whole
+// 40x30 board is 19 words, so a plane is a few cache lines and unions, masks and
+// counts are a handful of word operations. nth() uses PDEP when compiled with BMI2
+// (-mbmi2 / -march=native) and a byte-wise broadword select otherwise.
+// BitBoard<0> is the same set with its size chosen at run time (DynamicBoard); both
+// share one implementation, BasicBitBoard.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace bits {
+
+inline int popcount(std::uint64_t x) {
+#if defined(_MSC_VER)
+    return int(__popcnt64(x));
+#elif defined(__POPCNT__)
+    return __builtin_popcountll(x);
+#else
+    // without -mpopcnt the builtin is a libgcc call; this stays inline
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return int((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// x != 0
+inline int lowest(std::uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i, x);
+    return int(i);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+// Position of the n-th (0-based) set bit of x; n < popcount(x).
+inline int select(std::uint64_t x, int n) {
+#if defined(__BMI2__)
+    return lowest(_pdep_u64(std::uint64_t(1) << n, x));
+#else
+    // byte popcounts, then their running sums: byte k of `prefix` counts bits 0..8k+7
+    std::uint64_t c = x - ((x >> 1) & 0x5555555555555555ull);
+    c = (c & 0x3333333333333333ull) + ((c >> 2) & 0x3333333333333333ull);
+    c = (c + (c >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    const std::uint64_t prefix = c * 0x0101010101010101ull;
+    int byte = 0;
+    while (int((prefix >> (8 * byte)) & 0xFF) <= n) ++byte;
+    if (byte > 0) n -= int((prefix >> (8 * (byte - 1))) & 0xFF);
+    std::uint64_t b = (x >> (8 * byte)) & 0xFF;
+    for (; n > 0; --n) b &= b - 1;
+    return 8 * byte + lowest(b);
+#endif
+}
+
+} // namespace bits
+
+// The set operations, written once over the word storage: a std::array for fixed
+// boards (its size is a constant, so every loop has a compile-time trip count and
+// unrolls) or a std::vector for DynamicBoard. Derived is the concrete BitBoard, so
+// the operators return it. Binary operations expect both sides to have the same size.
+template <class Derived, class Words>
+class BasicBitBoard {
+public:
+    BasicBitBoard() = default;
+
+    int words() const { return int(w.size()); }
+
+    bool test(int i) const { return (w[i >> 6] >> (i & 63)) & 1u; }
+    void set(int i) { w[i >> 6] |= std::uint64_t(1) << (i & 63); }
+    void reset(int i) { w[i >> 6] &= ~(std::uint64_t(1) << (i & 63)); }
+    void clear() { std::fill(w.begin(), w.end(), 0); }
+    // Sets bits [begin, end).
+    void setRange(int begin, int end) {
+        while (begin < end) {
+            int k = begin >> 6, lo = begin & 63;
+            int hi = (end - (k << 6)) < 64 ? (end & 63) : 64;
+            std::uint64_t m = (hi == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << hi) - 1) & (~std::uint64_t(0) << lo);
+            w[k] |= m;
+            begin = (k + 1) << 6;
+        }
+    }
+
+    bool any() const {
+        for (std::uint64_t x : w) if (x) return true;
+        return false;
+    }
+
+    int count() const {
+        int n = 0;
+        for (std::uint64_t x : w) n += bits::popcount(x);
+        return n;
+    }
+
+    // Index of the n-th (0-based) set bit; n < count().
+    int nth(int n) const {
+        for (int k = 0; k < words(); ++k) {
+            int c = bits::popcount(w[k]);
+            if (n < c) return k * 64 + bits::select(w[k], n);
+            n -= c;
+        }
+        return -1;
+    }
+
+    // Calls f(index) for every set bit, in increasing order.
+    template <class F>
+    void forEach(F&& f) const {
+        for (int k = 0; k < words(); ++k) {
+            for (std::uint64_t x = w[k]; x; x &= x - 1) f(k * 64 + bits::lowest(x));
+        }
+    }
+
+    Derived& operator|=(const Derived& o) { for (int k = 0; k < words(); ++k) w[k] |= o.w[k]; return self(); }
+    Derived& operator&=(const Derived& o) { for (int k = 0; k < words(); ++k) w[k] &= o.w[k]; return self(); }
+    Derived operator|(const Derived& o) const { Derived r = self(); return r |= o; }
+    Derived operator&(const Derived& o) const { Derived r = self(); return r &= o; }
+    // this & ~o
+    Derived without(const Derived& o) const {
+        Derived r = self();
+        for (int k = 0; k < words(); ++k) r.w[k] &= ~o.w[k];
+        return r;
+    }
+
+    // Every bit moved s places towards higher (shl) or lower (shr) indices, 0 < s < 64.
+    // Bits shifted past the size are kept in the last word; mask with a real plane to
+    // drop them.
+    Derived shl(int s) const {
+        Derived r = self();
+        for (int k = words() - 1; k > 0; --k) r.w[k] = (w[k] << s) | (w[k - 1] >> (64 - s));
+        if (words() > 0) r.w[0] = w[0] << s;
+        return r;
+    }
+    Derived shr(int s) const {
+        Derived r = self();
+        for (int k = 0; k < words() - 1; ++k) r.w[k] = (w[k] >> s) | (w[k + 1] << (64 - s));
+        if (words() > 0) r.w[words() - 1] = w[words() - 1] >> s;
+        return r;
+    }
+
+    bool operator==(const Derived& o) const { return w == o.w; }
+    bool operator!=(const Derived& o) const { return w != o.w; }
+
+    std::uint64_t word(int k) const { return w[k]; }
+    void setWord(int k, std::uint64_t v) { w[k] = v; }
+
+protected:
+    explicit BasicBitBoard(Words words) : w(std::move(words)) {}
+
+    Words w{};
+
+private:
+    Derived& self() { return static_cast<Derived&>(*this); }
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+template <int N>
+class BitBoard : public BasicBitBoard<BitBoard<N>, std::array<std::uint64_t, (N + 63) / 64>> {
+public:
+    static constexpr int WORDS = (N + 63) / 64;
+};
+
+// Runtime-sized plane.
+template <>
+class BitBoard<0> : public BasicBitBoard<BitBoard<0>, std::vector<std::uint64_t>> {
+public:
+    BitBoard() = default;
+    explicit BitBoard(int n) : BasicBitBoard(std::vector<std::uint64_t>(std::size_t((n + 63) / 64))) {}
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+// Board geometry for the rules in SnakeSim.h.
+//
+// Board<W, H> fixes the size at compile time: index math folds to constants, plane
+// loops have a known trip count, and per-cell storage is inline, so a game on it is
+// still one trivially copyable block. DynamicBoard takes any size from
+// MIN_BOARD_SIDE to MAX_BOARD_SIDE at run time and keeps per-cell storage on the
+// heap. BasicSnakeSim<B> is written once against both; withBoard() (SnakeSim.h)
+// picks the compiled-in size when there is one.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "BitBoard.h"
+
+// The window's board, and the one everything not templated on the board uses.
+constexpr int   WIDTH = 40;
+constexpr int   HEIGHT = 30;
+
+constexpr int MIN_BOARD_SIDE = 10;
+constexpr int MAX_BOARD_SIDE = 1024;
+
+struct Cell {
+    int x = 0;
+    int y = 0;
+};
+
+inline bool operator==(Cell a, Cell b) { return a.x == b.x && a.y == b.y; }
+inline bool operator!=(Cell a, Cell b) { return !(a == b); }
+inline Cell operator+(Cell a, Cell b) { return { a.x + b.x, a.y + b.y }; }
+
+// Cells x0..x1, y0..y1 inclusive, clipped to the board.
+template <class B>
+typename B::Plane boardRect(const B& b, int x0, int x1, int y0, int y1) {
+    typename B::Plane p = b.plane();
+    x0 = std::max(x0, 0); x1 = std::min(x1, b.width() - 1);
+    y0 = std::max(y0, 0); y1 = std::min(y1, b.height() - 1);
+    if (x0 > x1) return p;
+    for (int y = y0; y <= y1; ++y) p.setRange(b.index({ x0, y }), b.index({ x1, y }) + 1);
+    return p;
+}
+
+template <int W, int H>
+struct Board {
+    static_assert(W >= MIN_BOARD_SIDE && W <= MAX_BOARD_SIDE && H >= MIN_BOARD_SIDE && H <= MAX_BOARD_SIDE,
+        "board side out of range");
+
+    static constexpr bool FIXED = true;
+
+    // packed cell index (y * W + x)
+    using Index = std::conditional_t<(W * H <= 65536), std::uint16_t, std::uint32_t>;
+    using Plane = BitBoard<W * H>;
+    template <class T> using Cells = std::array<T, W * H>;
+    template <class T> using HalfCells = std::array<T, W * H / 2>;
+
+    constexpr int width() const { return W; }
+    constexpr int height() const { return H; }
+    constexpr int cells() const { return W * H; }
+    constexpr int index(Cell c) const { return c.y * W + c.x; }
+    constexpr Cell cell(int i) const { return { i % W, i / W }; }
+
+    // Empty storage of the right size.
+    template <class T> Cells<T> cellArray() const { return {}; }
+    template <class T> HalfCells<T> halfArray() const { return {}; }
+    Plane plane() const { return {}; }
+    Plane rect(int x0, int x1, int y0, int y1) const { return boardRect(*this, x0, x1, y0, y1); }
+
+    bool operator==(const Board&) const { return true; }
+};
+
+class DynamicBoard {
+public:
+    static constexpr bool FIXED = false;
+
+    using Index = std::uint32_t;
+    using Plane = BitBoard<0>;
+    template <class T> using Cells = std::vector<T>;
+    template <class T> using HalfCells = std::vector<T>;
+
+    // Sides are clamped to [MIN_BOARD_SIDE, MAX_BOARD_SIDE].
+    explicit DynamicBoard(int width = WIDTH, int height = HEIGHT)
+        : w(std::clamp(width, MIN_BOARD_SIDE, MAX_BOARD_SIDE)),
+          h(std::clamp(height, MIN_BOARD_SIDE, MAX_BOARD_SIDE)) {}
+
+    int width() const { return w; }
+    int height() const { return h; }
+    int cells() const { return w * h; }
+    int index(Cell c) const { return c.y * w + c.x; }
+    Cell cell(int i) const { return { i % w, i / w }; }
+
+    template <class T> Cells<T> cellArray() const { return Cells<T>(std::size_t(cells())); }
+    template <class T> HalfCells<T> halfArray() const { return HalfCells<T>(std::size_t(cells() / 2)); }
+    Plane plane() const { return Plane(cells()); }
+    Plane rect(int x0, int x1, int y0, int y1) const { return boardRect(*this, x0, x1, y0, y1); }
+
+    bool operator==(const DynamicBoard& o) const { return w == o.w && h == o.h; }
+
+private:
+    int w;
+    int h;
+};
+
+using DefaultBoard = Board<WIDTH, HEIGHT>;
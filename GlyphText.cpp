@@ -0,0 +1,111 @@
+#include "GlyphText.h"
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr int FIRST_CHAR = 32, LAST_CHAR = 126;
+
+// --- atlas ---
+
+void GlyphAtlas::bake(unsigned size, const std::string& chars) {
+    Size s;
+    s.size = size;
+    if (chars.empty())
+        for (int c = FIRST_CHAR; c <= LAST_CHAR; ++c) s.chars += char(c);
+    else
+        s.chars = chars;
+    sizes.push_back(std::move(s));
+}
+
+bool GlyphAtlas::build() {
+    for (Size& s : sizes) {
+        // rasterize every glyph first: the page texture may grow while doing so
+        for (char c : s.chars) font.getGlyph(sf::Uint8(c), s.size, false);
+        const sf::Image page = font.getTexture(s.size).copyToImage();
+
+        s.glyphs.assign(LAST_CHAR - FIRST_CHAR + 1, Glyph());
+        s.ids.assign(s.glyphs.size(), -1);
+        for (char c : s.chars) {
+            if (c < FIRST_CHAR || c > LAST_CHAR) continue;
+            const sf::Glyph& g = font.getGlyph(sf::Uint8(c), s.size, false);
+            Glyph& out = s.glyphs[std::size_t(c - FIRST_CHAR)];
+            out.bounds = g.bounds;
+            out.advance = g.advance;
+            if (g.textureRect.width > 0 && g.textureRect.height > 0)
+                s.ids[std::size_t(c - FIRST_CHAR)] = atlas.add(page, g.textureRect, g.textureRect.width, g.textureRect.height);
+        }
+    }
+    if (!atlas.build()) return false;
+
+    for (Size& s : sizes) {
+        for (std::size_t i = 0; i < s.glyphs.size(); ++i)
+            if (s.ids[i] >= 0) s.glyphs[i].tex = atlas.frect(s.ids[i]);
+        s.ids.clear();
+    }
+    return true;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::glyph(unsigned size, char c) const {
+    if (c < FIRST_CHAR || c > LAST_CHAR) return nullptr;
+    for (const Size& s : sizes) {
+        if (s.size != size || s.glyphs.empty()) continue;
+        if (s.chars.find(c) == std::string::npos) continue;
+        return &s.glyphs[std::size_t(c - FIRST_CHAR)];
+    }
+    return nullptr;
+}
+
+// --- retained text ---
+
+void HudText::setString(const std::string& s) {
+    if (s == str) return;
+    str = s;
+    layout();
+}
+
+void HudText::setFillColor(sf::Color c) {
+    if (c == color) return;
+    color = c;
+    for (sf::Vertex& v : quads) v.color = color;
+}
+
+void HudText::layout() {
+    quads.clear();
+    float x = 0.f;
+    const float y = float(size);   // baseline, as in sf::Text
+    float minX = 0.f, minY = 0.f, maxX = 0.f, maxY = 0.f;
+    bool any = false;
+    char prev = 0;
+    for (char c : str) {
+        const GlyphAtlas::Glyph* g = glyphs->glyph(size, c);
+        if (!g) continue;
+        if (prev) x += glyphs->kerning(prev, c, size);
+        prev = c;
+
+        const sf::FloatRect& t = g->tex;
+        if (t.width > 0.f) {
+            const float l = x + g->bounds.left, tp = y + g->bounds.top;
+            const float r = l + g->bounds.width, b = tp + g->bounds.height;
+            quads.emplace_back(sf::Vector2f(l, tp), color, sf::Vector2f(t.left, t.top));
+            quads.emplace_back(sf::Vector2f(r, tp), color, sf::Vector2f(t.left + t.width, t.top));
+            quads.emplace_back(sf::Vector2f(r, b), color, sf::Vector2f(t.left + t.width, t.top + t.height));
+            quads.emplace_back(sf::Vector2f(l, b), color, sf::Vector2f(t.left, t.top + t.height));
+            minX = any ? std::min(minX, l) : l;
+            minY = any ? std::min(minY, tp) : tp;
+            maxX = any ? std::max(maxX, r) : r;
+            maxY = any ? std::max(maxY, b) : b;
+            any = true;
+        }
+        x += g->advance;
+    }
+    bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+void HudText::appendTo(sf::VertexArray& batch) const {
+    // whole pixels keep the 1:1 glyphs sharp
+    const sf::Vector2f at(std::round(pos.x), std::round(pos.y));
+    for (sf::Vertex v : quads) {
+        v.position += at;
+        batch.append(v);
+    }
+}
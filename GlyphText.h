@@ -0,0 +1,80 @@
+#pragma once
+
+// Text drawn from glyphs baked once at startup. sf::Text rasterizes glyphs into the
+// font's per-size page textures on first use, and a fresh sf::Text per frame (or a
+// new character size) means glyph uploads mid-game and one draw call per string on
+// a different texture for every size. GlyphAtlas instead rasterizes the sizes and
+// characters the game uses up front and copies them into one TextureAtlas; HudText
+// is a retained string that lays its quads out again only when the string changes,
+// so a whole HUD appends into one vertex array and draws in one call.
+//
+// Layout follows sf::Text (baseline at the character size, kerning between pairs),
+// so a HudText sits where the sf::Text it replaces did.
+
+#include <SFML/Graphics.hpp>
+
+#include <string>
+#include <vector>
+
+#include "TextureAtlas.h"
+
+class GlyphAtlas {
+public:
+    struct Glyph {
+        sf::FloatRect bounds;     // relative to the pen on the baseline
+        sf::FloatRect tex;        // in the atlas; empty for blanks
+        float advance = 0.f;
+    };
+
+    explicit GlyphAtlas(const sf::Font& font_) : font(font_) {}
+
+    // Queues `chars` at `size` px; printable ASCII when empty. Call before build().
+    void bake(unsigned size, const std::string& chars = "");
+    // Rasterizes the queued glyphs and uploads the atlas; false if that failed.
+    bool build();
+
+    const sf::Texture& texture() const { return atlas.texture(); }
+    // Null when `c` was not baked at `size`.
+    const Glyph* glyph(unsigned size, char c) const;
+    float kerning(char a, char b, unsigned size) const { return font.getKerning(sf::Uint8(a), sf::Uint8(b), size); }
+
+private:
+    struct Size {
+        unsigned size = 0;
+        std::string chars;
+        std::vector<Glyph> glyphs;    // indexed by char - 32
+        std::vector<int> ids;         // atlas entries while building, -1 for blanks
+    };
+
+    const sf::Font& font;
+    std::vector<Size> sizes;
+    TextureAtlas atlas;
+};
+
+class HudText {
+public:
+    HudText(const GlyphAtlas& glyphs, unsigned size, sf::Color color = sf::Color::White)
+        : glyphs(&glyphs), size(size), color(color) {}
+
+    // Lays the glyphs out again only when `s` differs from the current string.
+    void setString(const std::string& s);
+    void setFillColor(sf::Color c);
+    void setPosition(float x, float y) { pos = { x, y }; }
+
+    const std::string& getString() const { return str; }
+    sf::FloatRect getLocalBounds() const { return bounds; }
+
+    // Appends the quads, moved to the position, to a Quads array.
+    void appendTo(sf::VertexArray& batch) const;
+
+private:
+    void layout();
+
+    const GlyphAtlas* glyphs;
+    unsigned size;
+    sf::Color color;
+    sf::Vector2f pos;
+    std::string str;
+    std::vector<sf::Vertex> quads;    // local coordinates
+    sf::FloatRect bounds;
+};
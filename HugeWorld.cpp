@@ -0,0 +1,143 @@
+#include "HugeWorld.h"
+
+#include <algorithm>
+
+// Clamped to the supported range and rounded up to whole chunks.
+static int worldSideFor(int requested) {
+    int s = std::max(MIN_HUGE_WORLD_SIDE, std::min(MAX_HUGE_WORLD_SIDE, requested));
+    return (s + CHUNK_SIDE - 1) & ~(CHUNK_SIDE - 1);
+}
+
+// --- chunks ---
+
+ChunkMap::ChunkMap(int side)
+    : worldSide(worldSideFor(side)), perSide(worldSide >> CHUNK_SHIFT),
+      dir(std::size_t(perSide) * std::size_t(perSide)) {}
+
+WorldChunk& ChunkMap::touch(int cx, int cy, bool& created) {
+    std::unique_ptr<WorldChunk>& k = dir[std::size_t(cy * perSide + cx)];
+    created = !k;
+    if (created) {
+        k.reset(new WorldChunk);
+        ++allocated;
+    }
+    return *k;
+}
+
+void ChunkMap::clear() {
+    for (auto& k : dir) k.reset();
+    allocated = 0;
+}
+
+// --- body ---
+
+void HugeSnakeBody::pushFront(Cell c) {
+    if (count == int(ring.size())) {
+        // unroll into a ring twice the size, tail first
+        std::vector<std::uint32_t> grown(ring.size() * 2);
+        for (int i = 0; i < count; ++i) grown[std::size_t(i)] = ring[std::size_t((head - count + 1 + i) & mask())];
+        ring.swap(grown);
+        head = count - 1;
+    }
+    head = (head + 1) & mask();
+    ring[std::size_t(head)] = std::uint32_t(c.y) * std::uint32_t(worldSide) + std::uint32_t(c.x);
+    ++count;
+}
+
+// --- world ---
+
+HugeWorld::HugeWorld(int side) : snake(worldSideFor(side)), chunks(side) {
+    start = { chunks.side() / 2, chunks.side() / 2 };
+}
+
+void HugeWorld::stock(int cx, int cy) {
+    bool created;
+    WorldChunk& k = chunks.touch(cx, cy, created);
+    if (!created) return;
+
+    // depends only on the seed and the chunk, never on what was explored first
+    Rng rng(worldSeed, 1 + std::uint64_t(cy) * std::uint64_t(chunks.chunksPerSide()) + std::uint64_t(cx));
+    const int x0 = cx << CHUNK_SHIFT, y0 = cy << CHUNK_SHIFT;
+    auto place = [&](int n, std::uint8_t t) {
+        for (int placed = 0, tries = 0; placed < n && tries < 4 * n; ++tries) {
+            int lx = rng.below(CHUNK_SIDE), ly = rng.below(CHUNK_SIDE);
+            int x = x0 + lx, y = y0 + ly;
+            // keep the starting lane clear
+            if (y >= start.y - 2 && y <= start.y + 2 && x >= start.x - 4 && x <= start.x + 12) continue;
+            std::uint8_t& cell = k.cells[(ly << CHUNK_SHIFT) | lx];
+            if (cell) continue;
+            cell = t;
+            ++placed;
+        }
+    };
+    place(HUGE_OBSTACLES_PER_CHUNK, CellObstacle);
+    place(HUGE_FOOD_PER_CHUNK, CellFood);
+}
+
+void HugeWorld::stockAround(Cell c) {
+    const int cx = c.x >> CHUNK_SHIFT, cy = c.y >> CHUNK_SHIFT;
+    const int last = chunks.chunksPerSide() - 1;
+    for (int y = std::max(cy - HUGE_STOCK_RADIUS, 0); y <= std::min(cy + HUGE_STOCK_RADIUS, last); ++y) {
+        for (int x = std::max(cx - HUGE_STOCK_RADIUS, 0); x <= std::min(cx + HUGE_STOCK_RADIUS, last); ++x) {
+            if (!chunks.find(x, y)) stock(x, y);
+        }
+    }
+}
+
+void HugeWorld::newGame() {
+    chunks.clear();
+    snake.clear();
+    dir = Right;
+    score = 0;
+    foodEaten = 0;
+    delayMs = INITIAL_DELAY_MS;
+    pendingGrowth = 0;
+    gameOver = false;
+
+    stockAround(start);
+    for (int k = STARTING_SNAKE_LENGTH - 1; k >= 0; --k) {
+        Cell c{ start.x - k, start.y };
+        snake.pushFront(c);
+        chunks.tag(c, CellSnake);
+    }
+}
+
+StepResult HugeWorld::step() {
+    StepResult r;
+    if (gameOver) return r;
+
+    Cell h = snake.front();
+    Cell head{ h.x + DIR_DX[dir], h.y + DIR_DY[dir] };
+    if (!chunks.inside(head) || (chunks.at(head) & (CellSnake | CellObstacle))) {
+        gameOver = true;
+        r.events |= EvDied;
+        return r;
+    }
+
+    // the chunks around the old head are stocked already, so only a crossing into
+    // another chunk can bring new ones into range
+    if ((head.x >> CHUNK_SHIFT) != (h.x >> CHUNK_SHIFT) || (head.y >> CHUNK_SHIFT) != (h.y >> CHUNK_SHIFT))
+        stockAround(head);
+
+    snake.pushFront(head);
+    chunks.tag(head, CellSnake);
+
+    if (chunks.at(head) & CellFood) {
+        chunks.untag(head, CellFood);
+        score += 10;
+        foodEaten++;
+        pendingGrowth += HUGE_GROWTH;
+        r.events |= EvAteFood;
+        r.eatenAt = head;
+        delayMs = std::max(MIN_DELAY_MS, delayMs - DELAY_DECREMENT_MS);
+    }
+
+    if (pendingGrowth > 0) {
+        --pendingGrowth;
+    }
+    else {
+        chunks.untag(snake.back(), CellSnake);
+        snake.popBack();
+    }
+    return r;
+}
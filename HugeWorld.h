@@ -0,0 +1,148 @@
+#pragma once
+
+// Huge-world mode: one snake on a world far bigger than the window (4096x4096 cells
+// by default) that can grow to tens of thousands of segments. Occupancy lives in
+// 64x64-cell chunks allocated the first time the snake comes near them, so memory
+// follows the explored area rather than the world size. Each new chunk is stocked
+// with food and obstacles by a generator seeded from the world seed and the chunk's
+// coordinates, so a seed always builds the same world whatever order it is explored
+// in. No levels, enemies or shrinking here; the world's edge is the wall.
+//
+// Plain C++ like SnakeSim; SnakeGame.cpp draws only the chunks under the camera.
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Rng.h"
+#include "SnakeSim.h"
+
+constexpr int CHUNK_SHIFT = 6;
+constexpr int CHUNK_SIDE = 1 << CHUNK_SHIFT;
+constexpr int CHUNK_CELLS = CHUNK_SIDE * CHUNK_SIDE;
+
+constexpr int HUGE_WORLD_SIDE = 4096;
+constexpr int MIN_HUGE_WORLD_SIDE = 4 * CHUNK_SIDE;
+constexpr int MAX_HUGE_WORLD_SIDE = 16384;   // packed cell indices stay below 2^28
+
+constexpr int HUGE_FOOD_PER_CHUNK = 6;
+constexpr int HUGE_OBSTACLES_PER_CHUNK = 12;
+constexpr int HUGE_GROWTH = 8;   // segments gained per food
+// chunks stocked around the head's chunk in each direction; one chunk is already
+// wider than the window, so food and obstacles exist before they scroll into view
+constexpr int HUGE_STOCK_RADIUS = 1;
+
+// 64x64 cells of CellTag bits.
+struct WorldChunk {
+    std::uint8_t cells[CHUNK_CELLS] = {};
+
+    std::uint8_t at(int lx, int ly) const { return cells[(ly << CHUNK_SHIFT) | lx]; }
+};
+
+// Square world of side x side cells as a directory of lazily allocated chunks. A
+// chunk that was never touched reads as empty and costs one null pointer.
+class ChunkMap {
+public:
+    explicit ChunkMap(int side = HUGE_WORLD_SIDE);
+
+    int side() const { return worldSide; }
+    int chunksPerSide() const { return perSide; }
+    bool inside(Cell c) const { return unsigned(c.x) < unsigned(worldSide) && unsigned(c.y) < unsigned(worldSide); }
+
+    // nullptr until the chunk is touched
+    const WorldChunk* find(int cx, int cy) const { return dir[std::size_t(cy * perSide + cx)].get(); }
+    // Allocates on first use; `created` says whether it just was.
+    WorldChunk& touch(int cx, int cy, bool& created);
+
+    // c must be inside()
+    std::uint8_t at(Cell c) const {
+        const WorldChunk* k = find(c.x >> CHUNK_SHIFT, c.y >> CHUNK_SHIFT);
+        return k ? k->at(c.x & (CHUNK_SIDE - 1), c.y & (CHUNK_SIDE - 1)) : 0;
+    }
+    // c must be inside(); its chunk is allocated if needed
+    void tag(Cell c, std::uint8_t t) { cellRef(c) |= t; }
+    void untag(Cell c, std::uint8_t t) { cellRef(c) &= std::uint8_t(~t); }
+
+    // Drops every chunk.
+    void clear();
+
+    int chunkCount() const { return allocated; }
+    std::size_t memoryBytes() const {
+        return dir.size() * sizeof(dir[0]) + std::size_t(allocated) * sizeof(WorldChunk);
+    }
+
+private:
+    std::uint8_t& cellRef(Cell c) {
+        bool created;
+        WorldChunk& k = touch(c.x >> CHUNK_SHIFT, c.y >> CHUNK_SHIFT, created);
+        return k.cells[((c.y & (CHUNK_SIDE - 1)) << CHUNK_SHIFT) | (c.x & (CHUNK_SIDE - 1))];
+    }
+
+    int worldSide;
+    int perSide;
+    std::vector<std::unique_ptr<WorldChunk>> dir;
+    int allocated = 0;
+};
+
+// Snake body as a ring of packed cell indices (y * side + x) that doubles when
+// full, so a long snake costs 4 bytes per segment and no per-step allocation.
+class HugeSnakeBody {
+public:
+    explicit HugeSnakeBody(int side) : worldSide(side), ring(64) {}
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Cell front() const { return unpack(ring[head]); }
+    Cell back() const { return unpack(ring[(head - count + 1) & mask()]); }
+    // i = 0 is the head
+    Cell operator[](int i) const { return unpack(ring[(head - i) & mask()]); }
+
+    void pushFront(Cell c);
+    void popBack() { --count; }
+    void clear() { count = 0; }
+
+private:
+    int mask() const { return int(ring.size()) - 1; }
+    Cell unpack(std::uint32_t i) const { return { int(i % unsigned(worldSide)), int(i / unsigned(worldSide)) }; }
+
+    int worldSide;
+    std::vector<std::uint32_t> ring;   // power-of-two size
+    int head = 0;
+    int count = 0;
+};
+
+class HugeWorld {
+public:
+    explicit HugeWorld(int side = HUGE_WORLD_SIDE);
+
+    HugeSnakeBody snake;
+    Direction dir = Right;
+    int score = 0;
+    int foodEaten = 0;
+    int delayMs = INITIAL_DELAY_MS;
+    int pendingGrowth = 0;   // segments still to add, one per step
+    bool gameOver = false;
+
+    void seed(std::uint64_t s) { worldSeed = s; }
+    // Empties the world and puts a new snake in the middle, heading right.
+    void newGame();
+
+    // Turns the snake unless that would reverse it onto itself.
+    void steer(Direction d) { if (d != Direction(dir ^ 1)) dir = d; }
+    // Advances the game by one tick (EvAteFood / EvDied only).
+    StepResult step();
+
+    int side() const { return chunks.side(); }
+    const ChunkMap& world() const { return chunks; }
+    std::uint8_t at(Cell c) const { return chunks.inside(c) ? chunks.at(c) : std::uint8_t(CellOuterWall); }
+
+private:
+    // Stocks every chunk within HUGE_STOCK_RADIUS of c's chunk that is still new.
+    void stockAround(Cell c);
+    void stock(int cx, int cy);
+
+    ChunkMap chunks;   // a chunk is allocated exactly when it is stocked
+    std::uint64_t worldSeed = 1;
+    Cell start;
+};
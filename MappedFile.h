@@ -0,0 +1,32 @@
+#pragma once
+
+// Read-only memory map of a whole file (replays, the asset pack). Pages are only
+// read when touched, so opening a large file costs one map call, not a copy.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only view of a whole file. Empty (ok() == false) if it cannot be opened.
+// `sequential` hints that it will be read front to back (replays); leave it off
+// for files read by random lookups.
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path, bool sequential = true);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return ptr != nullptr; }
+    const std::uint8_t* data() const { return ptr; }
+    std::size_t size() const { return len; }
+
+private:
+    const std::uint8_t* ptr = nullptr;
+    std::size_t len = 0;
+#if defined(_WIN32)
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+};
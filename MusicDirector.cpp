@@ -0,0 +1,116 @@
+#include "MusicDirector.h"
+
+#include <algorithm>
+
+#include "AssetLoader.h"
+
+MusicDirector::~MusicDirector() {
+    for (Track& tr : tracks) settle(tr);
+}
+
+bool MusicDirector::open(MusicTrack t, const AssetPack* pack, const std::string& name, bool loop) {
+    Track& tr = tracks[t];
+    settle(tr);
+    tr.ok = openMusic(pack, name, tr.music);
+    if (!tr.ok) return false;
+    tr.music.setLoop(loop);
+    tr.gain = 0.f;
+    prime(tr);
+    return true;
+}
+
+void MusicDirector::setVolume(float v) {
+    volume = std::max(0.f, std::min(100.f, v));
+    for (Track& tr : tracks)
+        if (tr.ok && !tr.busy) apply(tr);
+}
+
+void MusicDirector::play(MusicTrack t) {
+    if (t == current) {
+        resume();
+        return;
+    }
+    // a paused track has nothing audible to fade out
+    if (current >= 0 && paused) tracks[std::size_t(current)].gain = 0.f;
+    current = t;
+    paused = false;
+
+    // a track still pre-rolling is started by update() once it is ready
+    Track& tr = tracks[t];
+    if (tr.ok && !tr.busy) start(tr);
+}
+
+void MusicDirector::pause() {
+    if (current < 0 || paused) return;
+    paused = true;
+    Track& tr = tracks[std::size_t(current)];
+    if (tr.ok && !tr.busy) tr.music.pause();
+}
+
+void MusicDirector::resume() {
+    if (current < 0 || !paused) return;
+    paused = false;
+    Track& tr = tracks[std::size_t(current)];
+    if (tr.ok && !tr.busy) tr.music.play();
+}
+
+void MusicDirector::update(float dt) {
+    const float step = fadeTime > 0.f ? dt / fadeTime : 1.f;
+    for (int i = 0; i < TRACK_COUNT; ++i) {
+        Track& tr = tracks[std::size_t(i)];
+        if (!tr.ok || tr.busy) continue;
+        if (i == current) {
+            if (paused) continue;
+            if (tr.primed) start(tr);
+            if (tr.gain < 1.f) {
+                tr.gain = std::min(1.f, tr.gain + step);
+                apply(tr);
+            }
+        }
+        else if (!tr.primed) {
+            if (tr.gain > 0.f) {
+                tr.gain = std::max(0.f, tr.gain - step);
+                apply(tr);
+            }
+            if (tr.gain <= 0.f) prime(tr);
+        }
+    }
+}
+
+void MusicDirector::prime(Track& tr) {
+    settle(tr);
+    tr.primed = true;
+    tr.busy = true;
+    tr.rewinder = std::thread([&tr] {
+        tr.music.setVolume(0.f);
+        if (tr.music.getStatus() == sf::SoundSource::Stopped) {
+            // play() seeks to the start and launches the stream thread; pausing
+            // straight away leaves it filling the queue without starting the source
+            tr.music.play();
+            tr.music.pause();
+        }
+        else {
+            // seeking a paused stream restarts its thread in the paused state
+            tr.music.pause();
+            tr.music.setPlayingOffset(sf::Time::Zero);
+        }
+        tr.busy = false;
+    });
+}
+
+void MusicDirector::start(Track& tr) {
+    settle(tr);   // the rewinder has finished; this only reaps it
+    if (tr.music.getStatus() != sf::SoundSource::Playing) {
+        apply(tr);
+        tr.music.play();   // unpauses the pre-rolled stream
+    }
+    tr.primed = false;
+}
+
+void MusicDirector::settle(Track& tr) {
+    if (tr.rewinder.joinable()) tr.rewinder.join();
+}
+
+void MusicDirector::apply(Track& tr) {
+    tr.music.setVolume(volume * tr.gain);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+// Background music with crossfades and no stalls on screen changes. Every track is
+// kept pre-rolled: started and paused again at its beginning, so its streaming
+// thread has already decoded and queued the first buffers and play() only has to
+// unpause the source. Switching tracks fades the new one in and the old one out
+// over the fade time; once the old one is silent it is paused and rewound on a
+// helper thread (a rewind joins and restarts the stream thread, which can take a
+// frame or more), ready for the next switch.
+//
+// update() advances the fades and must be called once per frame.
+
+#include <SFML/Audio.hpp>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include "AssetPack.h"
+
+enum MusicTrack { TrackMenu, TrackGame, TrackGameOver, TRACK_COUNT };
+
+class MusicDirector {
+public:
+    MusicDirector() = default;
+    ~MusicDirector();   // waits for rewinds still running
+
+    MusicDirector(const MusicDirector&) = delete;
+    MusicDirector& operator=(const MusicDirector&) = delete;
+
+    // Opens `name` (pack first, loose file second) and starts pre-rolling it.
+    bool open(MusicTrack t, const AssetPack* pack, const std::string& name, bool loop);
+
+    void setFadeTime(float seconds) { fadeTime = seconds; }
+    // 0..100, scaled by each track's fade.
+    void setVolume(float volume);
+
+    // Crossfades to `t`. A paused current track resumes; a track still fading out
+    // fades back in from where it is. Never waits: a track still pre-rolling starts
+    // on the first update() after it is ready.
+    void play(MusicTrack t);
+    // Pauses / resumes the current track at once (the in-game pause key).
+    void pause();
+    void resume();
+
+    void update(float dt);
+
+private:
+    struct Track {
+        sf::Music music;
+        bool ok = false;
+        float gain = 0.f;                 // 0..1, fade position
+        bool primed = false;              // paused at the start with buffers filled
+        std::thread rewinder;
+        std::atomic<bool> busy{ false };  // the rewinder owns `music`
+    };
+
+    void prime(Track& tr);        // rewinds on the helper thread
+    void start(Track& tr);        // plays a track that is not being rewound
+    void settle(Track& tr);       // waits for a rewind still running
+    void apply(Track& tr);
+
+    std::array<Track, TRACK_COUNT> tracks;
+    int current = -1;
+    bool paused = false;
+    float fadeTime = 0.75f;
+    float volume = 100.f;
+};
@@ -0,0 +1,64 @@
+#include "ParticlePool.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLES_SSE 1
+#include <emmintrin.h>
+#endif
+
+static int padTo4(int n) { return (n + 3) & ~3; }
+
+ParticlePool::ParticlePool(int capacity) : cap(std::max(0, capacity)) {
+    const int padded = padTo4(cap);
+    for (auto* v : { &x, &y, &vx, &vy, &life }) v->assign(std::size_t(padded), 0.f);
+}
+
+void ParticlePool::burst(Rng& rng, float cx, float cy, int n) {
+    n = std::min(n, cap - count);
+    for (int i = count; i < count + n; ++i) {
+        x[i] = cx;
+        y[i] = cy;
+        vx[i] = rng.uniform(-80.f, 80.f);
+        vy[i] = rng.uniform(-120.f, -30.f);
+        life[i] = rng.uniform(0.18f, PARTICLE_MAX_LIFE);
+    }
+    count += std::max(n, 0);
+}
+
+void ParticlePool::update(float dt) {
+    // integrate: the padding lanes past count hold stale values and are harmless
+    const int padded = padTo4(count);
+    const float g = PARTICLE_GRAVITY * dt;
+    int i = 0;
+#if defined(PARTICLES_SSE)
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 vg = _mm_set1_ps(g);
+    for (; i < padded; i += 4) {
+        __m128 l = _mm_sub_ps(_mm_loadu_ps(&life[i]), vdt);
+        __m128 u = _mm_loadu_ps(&vx[i]);
+        __m128 v = _mm_add_ps(_mm_loadu_ps(&vy[i]), vg);
+        _mm_storeu_ps(&life[i], l);
+        _mm_storeu_ps(&vy[i], v);
+        _mm_storeu_ps(&x[i], _mm_add_ps(_mm_loadu_ps(&x[i]), _mm_mul_ps(u, vdt)));
+        _mm_storeu_ps(&y[i], _mm_add_ps(_mm_loadu_ps(&y[i]), _mm_mul_ps(v, vdt)));
+    }
+#endif
+    for (; i < padded; ++i) {
+        life[i] -= dt;
+        vy[i] += g;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+
+    // swap-remove: the last live particle fills each hole
+    for (int k = 0; k < count; ) {
+        if (life[k] > 0.f) { ++k; continue; }
+        --count;
+        x[k] = x[count];
+        y[k] = y[count];
+        vx[k] = vx[count];
+        vy[k] = vy[count];
+        life[k] = life[count];
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// Fixed-capacity particle pool, structure-of-arrays. Positions, velocities and
+// lifetimes sit in flat float arrays so update() integrates four particles per SSE
+// instruction (plain loops without SSE); dead particles are swap-removed, so the
+// live ones are always the first size() entries and nothing is ever allocated after
+// construction. Spawning past capacity drops the excess rather than growing.
+//
+// Plain C++ like SnakeSim; SnakeGame.cpp turns the live entries into one vertex array.
+
+#include <vector>
+
+#include "Rng.h"
+
+constexpr int MAX_PARTICLES = 1 << 16;
+constexpr float PARTICLE_GRAVITY = 260.f;      // px/s^2, downwards
+constexpr float PARTICLE_MAX_LIFE = 0.35f;     // seconds
+
+class ParticlePool {
+public:
+    explicit ParticlePool(int capacity = MAX_PARTICLES);
+
+    int size() const { return count; }
+    int capacity() const { return cap; }
+
+    // `n` particles thrown up and outwards from (cx, cy).
+    void burst(Rng& rng, float cx, float cy, int n);
+    // Integrates dt seconds and removes the particles whose life ran out.
+    void update(float dt);
+    void clear() { count = 0; }
+
+    // --- SoA state; entries [0, size()) are live (arrays padded to a multiple of 4) ---
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<float> life;
+
+private:
+    int cap;
+    int count = 0;
+};
@@ -0,0 +1,147 @@
+#include "Replay.h"
+
+#include <cstring>
+#include <fstream>
+
+// File layout, all little-endian:
+//   "SNKR" u32 version, u64 seed, u32 level, u32 mode, u64 ticks, i32 score, u32 inputs,
+//   u32 enemies
+//   then `inputs` LEB128 varints of (tickDelta << 2 | dir)
+static const char REPLAY_MAGIC[4] = { 'S', 'N', 'K', 'R' };
+// bumped whenever the game rules or spawn order change, so stale replays are rejected
+static constexpr std::uint32_t REPLAY_VERSION = 3;
+static constexpr std::size_t REPLAY_HEADER_SIZE = 44;
+
+static void putLE(std::vector<std::uint8_t>& out, std::uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(std::uint8_t(v >> (8 * i)));
+}
+
+static std::uint64_t getLE(const std::uint8_t* p, int bytes) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) v |= std::uint64_t(p[i]) << (8 * i);
+    return v;
+}
+
+static void putVarint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(std::uint8_t(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(std::uint8_t(v));
+}
+
+// --- recording ---
+
+void ReplayRecorder::begin(std::uint64_t seed, int level, PlayMode mode, int enemies) {
+    info = ReplayInfo{};
+    info.seed = seed;
+    info.level = level;
+    info.mode = mode;
+    info.enemies = enemies;
+    body.clear();
+    tick = 0;
+    lastTick = 0;
+    last = Right;   // every game starts heading right
+}
+
+void ReplayRecorder::record(Direction d) {
+    if (d != last) {
+        putVarint(body, (std::uint64_t(tick - lastTick) << 2) | std::uint64_t(d));
+        lastTick = tick;
+        last = d;
+        info.inputCount++;
+    }
+    ++tick;
+}
+
+std::vector<std::uint8_t> ReplayRecorder::bytes() const {
+    std::vector<std::uint8_t> out;
+    out.reserve(REPLAY_HEADER_SIZE + body.size());
+    for (char c : REPLAY_MAGIC) out.push_back(std::uint8_t(c));
+    putLE(out, REPLAY_VERSION, 4);
+    putLE(out, info.seed, 8);
+    putLE(out, std::uint32_t(info.level), 4);
+    putLE(out, std::uint32_t(info.mode), 4);
+    putLE(out, std::uint64_t(info.ticks), 8);
+    putLE(out, std::uint32_t(info.finalScore), 4);
+    putLE(out, info.inputCount, 4);
+    putLE(out, std::uint32_t(info.enemies), 4);
+    out.insert(out.end(), body.begin(), body.end());
+    return out;
+}
+
+bool ReplayRecorder::save(const std::string& path) const {
+    std::vector<std::uint8_t> out = bytes();
+    std::ofstream f(path, std::ios::binary);
+    f.write(reinterpret_cast<const char*>(out.data()), std::streamsize(out.size()));
+    return bool(f);
+}
+
+// --- decoding ---
+
+ReplayReader::ReplayReader(const std::uint8_t* data, std::size_t size) {
+    if (!data || size < REPLAY_HEADER_SIZE) return;
+    if (std::memcmp(data, REPLAY_MAGIC, 4) != 0) return;
+    if (getLE(data + 4, 4) != REPLAY_VERSION) return;
+
+    info.seed = getLE(data + 8, 8);
+    info.level = int(getLE(data + 16, 4));
+    info.mode = PlayMode(getLE(data + 20, 4));
+    info.ticks = std::int64_t(getLE(data + 24, 8));
+    info.finalScore = std::int32_t(std::uint32_t(getLE(data + 32, 4)));
+    info.inputCount = std::uint32_t(getLE(data + 36, 4));
+    info.enemies = int(getLE(data + 40, 4));
+    if (info.level < 1 || info.level > MAX_LEVEL) return;
+    if (info.enemies < 0 || info.enemies > MAX_ENEMIES) return;
+    if (info.mode != PickLevel && info.mode != CycleLevel) return;
+
+    cur = data + REPLAY_HEADER_SIZE;
+    end = data + size;
+    ok = true;
+}
+
+bool ReplayReader::next(ReplayInput& in) {
+    std::uint64_t v = 0;
+    for (int shift = 0; ; shift += 7) {
+        if (cur == end || shift > 63) return false;
+        std::uint8_t b = *cur++;
+        v |= std::uint64_t(b & 0x7F) << shift;
+        if (!(b & 0x80)) break;
+    }
+    tick += std::int64_t(v >> 2);
+    in.tick = tick;
+    in.dir = Direction(v & 3);
+    return true;
+}
+
+// --- playback ---
+
+void ReplayPlayer::start(const ReplayReader& r, SnakeSim& sim) {
+    reader = r;
+    tick = 0;
+    havePending = reader.next(pending);
+
+    const ReplayInfo& h = reader.header();
+    sim.seed(h.seed);
+    sim.level = h.level;
+    sim.swarmSize = h.enemies;
+    sim.newGame(h.mode);
+}
+
+StepResult ReplayPlayer::step(SnakeSim& sim) {
+    // the log holds the heading each step actually used, so it is applied as-is
+    while (havePending && pending.tick <= tick) {
+        sim.dir = pending.dir;
+        havePending = reader.next(pending);
+    }
+    ++tick;
+    return sim.step();
+}
+
+bool playReplay(const ReplayReader& r, SnakeSim& sim) {
+    ReplayPlayer player;
+    player.start(r, sim);
+    while (!player.finished(sim)) player.step(sim);
+    // recordings end on a death, so a replay still alive at the last tick has diverged
+    return sim.gameOver && player.ticksPlayed() == r.header().ticks && sim.score == r.header().finalScore;
+}
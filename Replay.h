@@ -0,0 +1,92 @@
+#pragma once
+
+// Input-log replays. A game is fully determined by its seed, starting level, play
+// mode, swarm size and the heading used on every tick, so that is all a replay stores: a fixed
+// header plus one varint per direction change, ((ticks since last change) << 2 | dir).
+// A long level-3 run is a few KB. Files are read through a memory map, so scanning
+// a large corpus only touches the pages actually decoded.
+
+#include "MappedFile.h"
+#include "SnakeSim.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ReplayInfo {
+    std::uint64_t seed = 0;
+    int level = 1;
+    PlayMode mode = PickLevel;
+    std::int64_t ticks = 0;       // steps played
+    int finalScore = 0;
+    std::uint32_t inputCount = 0; // direction changes
+    int enemies = 1;              // SnakeSim::swarmSize
+};
+
+struct ReplayInput {
+    std::int64_t tick = 0;   // applied right before this step
+    Direction dir = Right;
+};
+
+// Builds a replay while a game is played.
+class ReplayRecorder {
+public:
+    // Call with the values the game is about to be started with (sim.level before newGame()).
+    void begin(std::uint64_t seed, int level, PlayMode mode, int enemies = 1);
+    // Call once per tick, right before stepping, with the heading that step will use.
+    void record(Direction d);
+    void finish(int finalScore) { info.finalScore = finalScore; info.ticks = tick; }
+
+    std::vector<std::uint8_t> bytes() const;
+    bool save(const std::string& path) const;
+
+private:
+    ReplayInfo info;
+    std::vector<std::uint8_t> body;
+    std::int64_t tick = 0;
+    std::int64_t lastTick = 0;
+    Direction last = Right;
+};
+
+// Decodes a replay from memory owned by the caller (usually a MappedFile).
+class ReplayReader {
+public:
+    ReplayReader() = default;
+    ReplayReader(const std::uint8_t* data, std::size_t size);
+
+    bool valid() const { return ok; }
+    const ReplayInfo& header() const { return info; }
+
+    // Next direction change; false at the end or on truncated data.
+    bool next(ReplayInput& in);
+
+private:
+    ReplayInfo info;
+    const std::uint8_t* cur = nullptr;
+    const std::uint8_t* end = nullptr;
+    std::int64_t tick = 0;
+    bool ok = false;
+};
+
+// Feeds a replay's inputs into a game tick by tick.
+class ReplayPlayer {
+public:
+    // Seeds and starts `sim` exactly as the recorded game was.
+    void start(const ReplayReader& r, SnakeSim& sim);
+    // Applies this tick's input, if any, and steps.
+    StepResult step(SnakeSim& sim);
+    // The recorded game is over (or the log ran out).
+    bool finished(const SnakeSim& sim) const { return sim.gameOver || tick >= reader.header().ticks; }
+    std::int64_t ticksPlayed() const { return tick; }
+
+private:
+    ReplayReader reader;
+    ReplayInput pending;
+    bool havePending = false;
+    std::int64_t tick = 0;
+};
+
+// Plays a whole replay as fast as possible. Returns true if the snake dies on the
+// recorded tick with the recorded score.
+bool playReplay(const ReplayReader& r, SnakeSim& sim);
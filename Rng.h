@@ -0,0 +1,52 @@
+#pragma once
+
+// Small, fast, seedable generator (xoshiro256**, seeded through splitmix64).
+// Each game owns its own instance, so games on different threads never share state
+// and a given seed always replays the same game.
+
+#include <cstdint>
+
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed = 1, std::uint64_t stream = 0) { reseed(seed, stream); }
+
+    // Different `stream`s from the same seed are independent sequences
+    // (e.g. gameplay vs. cosmetic effects).
+    void reseed(std::uint64_t seed, std::uint64_t stream = 0) {
+        std::uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ull);
+        for (auto& w : s) w = splitmix64(x);
+    }
+
+    std::uint64_t next() {
+        const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform integer in [0, n), n > 0 (multiply-shift, no modulo bias worth caring about here).
+    int below(int n) {
+        return int((std::uint64_t(std::uint32_t(next() >> 32)) * std::uint64_t(n)) >> 32);
+    }
+
+    // Uniform float in [a, b).
+    float uniform(float a, float b) {
+        return a + (b - a) * (float(next() >> 40) * (1.0f / 16777216.0f));
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    static std::uint64_t splitmix64(std::uint64_t& x) {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t s[4];
+};
@@ -0,0 +1,150 @@
+#include "RolloutRunner.h"
+
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int threads) {
+    if (threads <= 0) threads = int(std::thread::hardware_concurrency());
+    if (threads <= 0) threads = 1;
+    ranges.reset(new Range[threads]);
+    workers.reserve(threads);
+    for (int i = 0; i < threads; ++i)
+        workers.emplace_back([this, i] { workerLoop(i); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lk(jobLock);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (auto& t : workers) t.join();
+}
+
+void WorkStealingPool::parallelFor(std::int64_t n, const std::function<void(std::int64_t, int)>& fn,
+    std::int64_t grain_) {
+    if (n <= 0) return;
+    const int T = threadCount();
+
+    std::unique_lock<std::mutex> lk(jobLock);
+    for (int k = 0; k < T; ++k) {
+        std::lock_guard<std::mutex> rl(ranges[k].lock);
+        ranges[k].begin = n * k / T;
+        ranges[k].end = n * (k + 1) / T;
+    }
+    job = &fn;
+    grain = std::max<std::int64_t>(1, grain_);
+    busy = T;
+    ++jobId;
+    jobReady.notify_all();
+    jobDone.wait(lk, [&] { return busy == 0; });
+    job = nullptr;
+}
+
+bool WorkStealingPool::takeOwn(int id, std::int64_t& b, std::int64_t& e) {
+    Range& r = ranges[id];
+    std::lock_guard<std::mutex> lk(r.lock);
+    if (r.begin >= r.end) return false;
+    e = r.end;
+    b = std::max(r.begin, r.end - grain);
+    r.end = b;
+    return true;
+}
+
+bool WorkStealingPool::steal(int id, std::int64_t& b, std::int64_t& e) {
+    const int T = threadCount();
+    for (int k = 1; k < T; ++k) {
+        Range& victim = ranges[(id + k) % T];
+        std::int64_t sb, se;
+        {
+            std::lock_guard<std::mutex> lk(victim.lock);
+            std::int64_t left = victim.end - victim.begin;
+            if (left <= 0) continue;
+            std::int64_t take = left <= grain ? left : left / 2;
+            sb = victim.begin;
+            se = sb + take;
+            victim.begin = se;
+        }
+        // park the loot in our own range so it can be split again by others
+        {
+            std::lock_guard<std::mutex> lk(ranges[id].lock);
+            ranges[id].begin = sb;
+            ranges[id].end = se;
+        }
+        return takeOwn(id, b, e);
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(int id) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        const std::function<void(std::int64_t, int)>* fn;
+        {
+            std::unique_lock<std::mutex> lk(jobLock);
+            jobReady.wait(lk, [&] { return stopping || jobId != seen; });
+            if (stopping) return;
+            seen = jobId;
+            fn = job;
+        }
+
+        std::int64_t b, e;
+        while (takeOwn(id, b, e) || steal(id, b, e)) {
+            for (std::int64_t i = b; i < e; ++i) (*fn)(i, id);
+        }
+
+        std::lock_guard<std::mutex> lk(jobLock);
+        if (--busy == 0) jobDone.notify_one();
+    }
+}
+
+namespace {
+// One per worker, on its own cache lines.
+struct alignas(64) WorkerState {
+    SnakeSim sim;
+    std::unique_ptr<Policy> policy;
+    RolloutStats stats;
+};
+}
+
+RolloutStats runRollouts(WorkStealingPool& pool, const RolloutConfig& cfg,
+    const PolicyFactory& makePolicy, std::vector<EpisodeResult>* results) {
+    std::vector<std::unique_ptr<WorkerState>> states(pool.threadCount());
+    for (auto& st : states) {
+        st.reset(new WorkerState);
+        st->policy = makePolicy();
+    }
+    if (results) results->assign(std::size_t(std::max<std::int64_t>(cfg.episodes, 0)), EpisodeResult{});
+
+    pool.parallelFor(cfg.episodes, [&](std::int64_t ep, int worker) {
+        WorkerState& st = *states[worker];
+        SnakeSim& sim = st.sim;
+        std::uint64_t seed = cfg.seed + std::uint64_t(ep);
+
+        sim.seed(seed);
+        sim.level = cfg.level;
+        sim.swarmSize = cfg.enemies;
+        sim.newGame(cfg.mode);
+        st.policy->begin(sim, seed);
+
+        std::int64_t ticks = 0;
+        while (!sim.gameOver && ticks < cfg.maxTicks) {
+            sim.step(st.policy->act(sim));
+            ++ticks;
+        }
+
+        st.stats.episodes++;
+        st.stats.ticks += ticks;
+        st.stats.totalScore += sim.score;
+        st.stats.bestScore = std::max(st.stats.bestScore, sim.score);
+        if (results) (*results)[std::size_t(ep)] = { seed, sim.score, sim.level, ticks };
+    });
+
+    RolloutStats total;
+    for (auto& st : states) {
+        total.episodes += st->stats.episodes;
+        total.ticks += st->stats.ticks;
+        total.totalScore += st->stats.totalScore;
+        total.bestScore = std::max(total.bestScore, st->stats.bestScore);
+    }
+    return total;
+}
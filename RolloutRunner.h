@@ -0,0 +1,95 @@
+#pragma once
+
+// Parallel headless rollouts. WorkStealingPool runs index ranges on every core;
+// runRollouts() plays one seeded episode per index with per-worker game state, so
+// nothing mutable is shared between threads.
+
+#include "SnakeSim.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads. Each parallelFor() splits [0, n) evenly across the
+// workers; a worker takes `grain`-sized pieces off the back of its own range and,
+// once that is empty, steals the front half of the next non-empty one.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads = 0);   // 0 = one per hardware thread
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int threadCount() const { return int(workers.size()); }
+
+    // Calls fn(index, worker) for every index in [0, n) and returns once all are done.
+    // `worker` is in [0, threadCount()) and identifies the calling thread's slot.
+    void parallelFor(std::int64_t n, const std::function<void(std::int64_t, int)>& fn,
+        std::int64_t grain = 16);
+
+private:
+    struct alignas(64) Range {
+        std::mutex lock;
+        std::int64_t begin = 0;
+        std::int64_t end = 0;
+    };
+
+    void workerLoop(int id);
+    bool takeOwn(int id, std::int64_t& b, std::int64_t& e);
+    bool steal(int id, std::int64_t& b, std::int64_t& e);
+
+    std::vector<std::thread> workers;
+    std::unique_ptr<Range[]> ranges;
+
+    std::mutex jobLock;
+    std::condition_variable jobReady, jobDone;
+    std::uint64_t jobId = 0;
+    bool stopping = false;
+    int busy = 0;
+
+    const std::function<void(std::int64_t, int)>* job = nullptr;
+    std::int64_t grain = 16;
+};
+
+// Something that picks the next direction. One instance per worker thread.
+struct Policy {
+    virtual ~Policy() = default;
+    // Called after the game for a new episode has been set up.
+    virtual void begin(const SnakeSim&, std::uint64_t /*seed*/) {}
+    virtual Direction act(const SnakeSim& sim) = 0;
+};
+
+using PolicyFactory = std::function<std::unique_ptr<Policy>()>;
+
+struct RolloutConfig {
+    std::int64_t episodes = 1000;
+    int level = 1;
+    PlayMode mode = PickLevel;
+    int enemies = 1;                  // SnakeSim::swarmSize
+    std::uint64_t seed = 1;           // episode i plays the game seeded with seed + i
+    std::int64_t maxTicks = 100000;   // cap for games that never end
+};
+
+struct EpisodeResult {
+    std::uint64_t seed = 0;
+    int score = 0;
+    int level = 0;
+    std::int64_t ticks = 0;
+};
+
+struct RolloutStats {
+    std::int64_t episodes = 0;
+    std::int64_t ticks = 0;
+    long long totalScore = 0;
+    int bestScore = 0;
+};
+
+// Plays cfg.episodes games across the pool. If `results` is given it is resized to
+// one entry per episode, indexed by episode number.
+RolloutStats runRollouts(WorkStealingPool& pool, const RolloutConfig& cfg,
+    const PolicyFactory& makePolicy, std::vector<EpisodeResult>* results = nullptr);
@@ -0,0 +1,93 @@
+#include "SfxPlayer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "AssetLoader.h"
+
+static constexpr unsigned SYNTH_RATE = 44100;
+
+bool SfxPlayer::load(SfxId id, const AssetPack* pack, const std::string& name) {
+    Clip& c = clips[id];
+    c.ok = loadSoundBuffer(pack, name, c.buffer);
+    c.duration = c.ok ? c.buffer.getDuration().asSeconds() : 0.f;
+    return c.ok;
+}
+
+void SfxPlayer::synthesize(SfxId id, std::initializer_list<float> notesHz, float noteSeconds) {
+    const int perNote = int(noteSeconds * SYNTH_RATE);
+    std::vector<sf::Int16> pcm;
+    pcm.reserve(notesHz.size() * std::size_t(perNote));
+    for (float hz : notesHz) {
+        double phase = 0.0;
+        for (int i = 0; i < perNote; ++i) {
+            // short attack, exponential decay: no clicks at the note edges
+            const float t = float(i) / float(perNote);
+            const float env = std::min(1.f, t * 40.f) * std::exp(-4.f * t) * (1.f - t);
+            const float sq = phase < 0.5 ? 1.f : -1.f;
+            pcm.push_back(sf::Int16(sq * env * 9000.f));
+            phase += hz / SYNTH_RATE;
+            phase -= std::floor(phase);
+        }
+    }
+    Clip& c = clips[id];
+    c.ok = c.buffer.loadFromSamples(pcm.data(), pcm.size(), 1, SYNTH_RATE);
+    c.duration = c.ok ? c.buffer.getDuration().asSeconds() : 0.f;
+}
+
+void SfxPlayer::setLimits(SfxId id, float minGap, int maxVoices, int priority) {
+    Clip& c = clips[id];
+    c.minGap = minGap;
+    c.maxVoices = std::max(1, std::min(maxVoices, VOICES));
+    c.priority = priority;
+}
+
+void SfxPlayer::setVolume(float v) {
+    volume = std::max(0.f, std::min(100.f, v));
+    for (Voice& voice : voices) voice.sound.setVolume(volume);
+}
+
+bool SfxPlayer::play(SfxId id, float pitch) {
+    Clip& c = clips[id];
+    if (!c.ok || volume <= 0.f) return false;
+    const float now = clock.getElapsedTime().asSeconds();
+    if (now - c.lastStart < c.minGap) return false;
+
+    // a free voice if there is one; failing that the oldest one we may take over,
+    // preferring this clip's own voices once it is at its overlap cap
+    int sameCount = 0, oldestSame = -1, free = -1, oldestOther = -1;
+    for (int i = 0; i < VOICES; ++i) {
+        const Voice& v = voices[std::size_t(i)];
+        if (v.clip < 0 || v.end <= now) { if (free < 0) free = i; continue; }
+        if (v.clip == id) {
+            ++sameCount;
+            if (oldestSame < 0 || v.start < voices[std::size_t(oldestSame)].start) oldestSame = i;
+        }
+        else if (clips[std::size_t(v.clip)].priority <= c.priority
+            && (oldestOther < 0 || v.start < voices[std::size_t(oldestOther)].start)) {
+            oldestOther = i;
+        }
+    }
+    int pick = sameCount >= c.maxVoices ? oldestSame : free >= 0 ? free : oldestOther >= 0 ? oldestOther : oldestSame;
+    if (pick < 0) return false;
+
+    Voice& v = voices[std::size_t(pick)];
+    if (v.clip != id) v.sound.setBuffer(c.buffer);   // setBuffer stops the voice
+    else v.sound.stop();
+    v.sound.setVolume(volume);
+    v.sound.setPitch(pitch);
+    v.sound.play();
+    v.clip = id;
+    v.start = now;
+    v.end = now + c.duration / std::max(pitch, 0.01f);
+    c.lastStart = now;
+    return true;
+}
+
+void SfxPlayer::stopAll() {
+    for (Voice& v : voices) {
+        if (v.clip >= 0) v.sound.stop();
+        v.end = 0.f;
+    }
+}
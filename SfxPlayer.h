@@ -0,0 +1,65 @@
+#pragma once
+
+// Sound effects from clips decoded into memory up front and played on a fixed set of
+// sf::Sound voices. Starting a voice on a resident buffer costs no decoding and no
+// new thread (unlike an sf::Music stream), so the crash sound lands on the frame the
+// snake dies. Bursts stay cheap too: each clip has a minimum gap between starts and
+// a cap on how many of its voices may overlap, and when every voice is busy the
+// oldest one of no higher priority is stolen instead of allocating another.
+//
+// Voice bookkeeping uses the clip durations rather than asking the sound device, so
+// play() never queries the voices it is not going to start.
+
+#include <SFML/Audio.hpp>
+
+#include <array>
+#include <initializer_list>
+#include <string>
+
+#include "AssetPack.h"
+
+enum SfxId { SfxEat, SfxBonus, SfxLevelUp, SfxCrash, SFX_COUNT };
+
+class SfxPlayer {
+public:
+    static constexpr int VOICES = 16;
+
+    // Decodes `name` (pack first, loose file second) into the clip; false if missing.
+    bool load(SfxId id, const AssetPack* pack, const std::string& name);
+    // Fills the clip with a short square-wave jingle, one `noteSeconds` note per
+    // frequency, for events that ship without a recording.
+    void synthesize(SfxId id, std::initializer_list<float> notesHz, float noteSeconds);
+
+    // At most one start every `minGap` seconds and `maxVoices` voices at once;
+    // a clip may only steal voices of equal or lower `priority`.
+    void setLimits(SfxId id, float minGap, int maxVoices, int priority);
+
+    // 0..100, applied to every voice.
+    void setVolume(float volume);
+
+    // Starts the clip unless it is rate limited or no voice can be had.
+    bool play(SfxId id, float pitch = 1.f);
+    void stopAll();
+
+private:
+    struct Clip {
+        sf::SoundBuffer buffer;
+        float duration = 0.f;
+        float minGap = 0.f;
+        int maxVoices = VOICES;
+        int priority = 0;
+        float lastStart = -1e9f;
+        bool ok = false;
+    };
+    struct Voice {
+        sf::Sound sound;
+        int clip = -1;
+        float start = 0.f;
+        float end = 0.f;      // when it falls silent, by the clip length and pitch
+    };
+
+    std::array<Clip, SFX_COUNT> clips;
+    std::array<Voice, VOICES> voices;
+    float volume = 100.f;
+    sf::Clock clock;
+};
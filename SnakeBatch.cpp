@@ -0,0 +1,120 @@
+#include "SnakeBatch.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+static int padTo8(int n) { return (n + 7) & ~7; }
+
+SnakeBatch::SnakeBatch(int n, int startLevel_, PlayMode mode_, std::uint64_t seed)
+    : count(n), startLevel(startLevel_), mode(mode_) {
+    int padded = padTo8(n);
+    for (auto* v : { &headX, &headY, &dir, &foodX, &foodY, &score, &foodEaten, &delayMs, &reward,
+                     &act, &nextX, &nextY, &hitWall })
+        v->assign(padded, 0);
+    done.assign(padded, 0);
+    events.assign(padded, 0);
+    games.resize(n);
+    for (int i = 0; i < n; ++i) games[i].rng.reseed(seed, std::uint64_t(i));
+    resetAll();
+}
+
+void SnakeBatch::resetAll() {
+    for (int i = 0; i < count; ++i) {
+        restart(i);
+        reward[i] = 0;
+        done[i] = 0;
+        events[i] = 0;
+    }
+}
+
+void SnakeBatch::restart(int i) {
+    games[i].level = startLevel;
+    games[i].newGame(mode);
+    sync(i);
+}
+
+void SnakeBatch::sync(int i) {
+    const SnakeSim& g = games[i];
+    Cell h = g.snake.front();
+    headX[i] = h.x;
+    headY[i] = h.y;
+    dir[i] = g.dir;
+    foodX[i] = g.food.x;
+    foodY[i] = g.food.y;
+    score[i] = g.score;
+    foodEaten[i] = g.foodEaten;
+    delayMs[i] = g.delayMs;
+}
+
+void SnakeBatch::stepBatch(const std::uint8_t* actions) {
+    const int padded = padTo8(count);
+
+    for (int i = 0; i < count; ++i) {
+        if (games[i].gameOver) restart(i);
+        act[i] = actions[i];
+    }
+
+    // lane pass: reject reversals, advance heads, test the outer walls
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256i dxLut = _mm256_setr_epi32(DIR_DX[0], DIR_DX[1], DIR_DX[2], DIR_DX[3], 0, 0, 0, 0);
+    const __m256i dyLut = _mm256_setr_epi32(DIR_DY[0], DIR_DY[1], DIR_DY[2], DIR_DY[3], 0, 0, 0, 0);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i four = _mm256_set1_epi32(4);
+    const __m256i maxX = _mm256_set1_epi32(WIDTH - 2);
+    const __m256i maxY = _mm256_set1_epi32(HEIGHT - 2);
+    for (; i < padded; i += 8) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)&act[i]);
+        __m256i d = _mm256_loadu_si256((const __m256i*)&dir[i]);
+
+        __m256i inRange = _mm256_cmpgt_epi32(four, a);
+        __m256i reverse = _mm256_cmpeq_epi32(a, _mm256_xor_si256(d, one));
+        __m256i take = _mm256_andnot_si256(reverse, inRange);
+        d = _mm256_blendv_epi8(d, a, take);
+
+        __m256i x = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)&headX[i]), _mm256_permutevar8x32_epi32(dxLut, d));
+        __m256i y = _mm256_add_epi32(_mm256_loadu_si256((const __m256i*)&headY[i]), _mm256_permutevar8x32_epi32(dyLut, d));
+
+        __m256i wall = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpgt_epi32(one, x), _mm256_cmpgt_epi32(x, maxX)),
+            _mm256_or_si256(_mm256_cmpgt_epi32(one, y), _mm256_cmpgt_epi32(y, maxY)));
+
+        _mm256_storeu_si256((__m256i*)&dir[i], d);
+        _mm256_storeu_si256((__m256i*)&nextX[i], x);
+        _mm256_storeu_si256((__m256i*)&nextY[i], y);
+        _mm256_storeu_si256((__m256i*)&hitWall[i], wall);
+    }
+#endif
+    for (; i < padded; ++i) {
+        std::int32_t a = act[i], d = dir[i];
+        d = (a >= 0 && a < 4 && a != (d ^ 1)) ? a : d;
+        std::int32_t x = headX[i] + DIR_DX[d];
+        std::int32_t y = headY[i] + DIR_DY[d];
+        dir[i] = d;
+        nextX[i] = x;
+        nextY[i] = y;
+        hitWall[i] = (x < 1) | (x > WIDTH - 2) | (y < 1) | (y > HEIGHT - 2) ? -1 : 0;
+    }
+
+    // per-game resolve; outer-wall crashes need nothing more than the flag
+    for (i = 0; i < count; ++i) {
+        SnakeSim& g = games[i];
+        int before = g.score;
+        g.dir = Direction(dir[i]);
+
+        StepResult r;
+        if (hitWall[i]) {
+            g.gameOver = true;
+            r.events = EvDied;
+        }
+        else {
+            r = g.advance({ nextX[i], nextY[i] });
+        }
+
+        sync(i);
+        reward[i] = g.score - before;
+        done[i] = g.gameOver ? 1 : 0;
+        events[i] = r.events;
+    }
+}
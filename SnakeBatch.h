@@ -0,0 +1,51 @@
+#pragma once
+
+// Many independent games advanced in lockstep with one call, for trainers that
+// consume observations in batches. The per-tick hot fields are mirrored
+// structure-of-arrays so the direction/head/wall pass runs across lanes (AVX2 when
+// compiled with -mavx2, plain loops otherwise); the rest of each tick (food,
+// enemies, shrinking) is resolved per game by SnakeSim::advance().
+
+#include "SnakeSim.h"
+
+#include <cstdint>
+#include <vector>
+
+class SnakeBatch {
+public:
+    // Lane i draws from stream i of `seed`, so a batch replays exactly for a given seed.
+    explicit SnakeBatch(int n, int startLevel = 1, PlayMode mode = PickLevel, std::uint64_t seed = 1);
+
+    int size() const { return count; }
+
+    // Starts a fresh game in every lane.
+    void resetAll();
+    // Advances every game one tick. actions[i] is a Direction for game i; any other
+    // value keeps the current heading. Games that ended on the previous call are
+    // restarted first, so done[] is only ever set for one step.
+    void stepBatch(const std::uint8_t* actions);
+
+    // --- SoA state, one entry per lane (padded to a multiple of 8) ---
+    std::vector<std::int32_t> headX, headY, dir;
+    std::vector<std::int32_t> foodX, foodY;
+    std::vector<std::int32_t> score, foodEaten;
+    std::vector<std::int32_t> delayMs;
+
+    // --- results of the last stepBatch() ---
+    std::vector<std::int32_t> reward;   // score change
+    std::vector<std::uint8_t> done;     // game ended this step
+    std::vector<std::uint32_t> events;  // SimEvent bits
+
+    std::vector<SnakeSim> games;
+
+private:
+    void restart(int i);
+    void sync(int i);
+
+    int count = 0;
+    int startLevel = 1;
+    PlayMode mode = PickLevel;
+
+    // scratch for the lane pass
+    std::vector<std::int32_t> act, nextX, nextY, hitWall;
+};
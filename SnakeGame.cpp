@@ -3,7 +3,7 @@
 #include <SFML/Audio.hpp>
 
 #include <vector>
-#include <deque>
+#include <memory>
 #include <ctime>
 #include <sstream>
 #include <iomanip>
@@ -21,94 +21,72 @@ namespace fs = std::filesystem;
 #endif
 
 
+#include "SnakeSim.h"
+#include "Replay.h"
+#include "Autopilot.h"
+#include "HugeWorld.h"
+#include "ParticlePool.h"
+#include "TextureAtlas.h"
+#include "AssetPack.h"
+#include "AssetLoader.h"
+#include "SfxPlayer.h"
+#include "MusicDirector.h"
+#include "GlyphText.h"
+
 constexpr int   CELL_SIZE = 16;
-constexpr int   WIDTH = 40;
-constexpr int   HEIGHT = 30;
-constexpr float INITIAL_DELAY = 0.15f;
-constexpr float MIN_DELAY = 0.06f;
-constexpr float DELAY_DECREMENT = 0.008f;
-constexpr int   FOODS_PER_LEVEL = 5;
-constexpr float BONUS_TIME = 5.0f;
-constexpr int   BONUS_MAX_SCORE = 400;
 constexpr int   MARGIN = 32;
 
-constexpr int   MAX_LEVEL = 3;
-const int LEVEL_UP_SCORES[MAX_LEVEL + 1] = { 0, 200, 500, INT_MAX };
-constexpr int STARTING_SNAKE_LENGTH = 3;
-
 // enemy animation constants (your sheet layout)
 constexpr int   ENEMY_COLS = 7;
 constexpr int   ENEMY_ROWS = 3;
 constexpr float ENEMY_FRAME_DURATION = 0.1f;
 
-enum Direction { Up, Down, Left, Right };
 enum GameState { Playing, Paused, GameOver };
 enum MenuState { MainMenu, InGame, PauseMenu, HighScoreMenu, MoodMenu, PickLevelMenu, SettingsMenu };
-enum PlayMode { PickLevel, CycleLevel };
-
-PlayMode playMode = PickLevel;
-
-struct Enemy {
-    sf::Vector2i pos;
-    float moveTimer = 0.f;
-    float moveDelay = 0.2f;
-};
-
-std::vector<Enemy> enemies;
-
-// --- shrink arena / warnings ---
-constexpr int MAX_SHRINK_TICKS = 5;
-int shrinkTicks = 0;
-const int SHRINK_FOOD_STEP = (FOODS_PER_LEVEL - 1) * 2;
-int nextShrinkFood = SHRINK_FOOD_STEP;
-
-bool warningActive = false;
-int  warningCount = 0;
-sf::Clock warningClock;
-
-int minX, maxX, minY, maxY;
-
-// --- enemy animation clock (FIX) ---
-sf::Clock enemyAnimClock;
 
 // --- screen shake (add-only) ---
-float shakeTime = 0.f;
-float shakeDuration = 0.20f;
-float shakeMagnitude = 6.f;
-
-static float frand(float a, float b) {
-    return a + (b - a) * (float(rand()) / float(RAND_MAX));
-}
+struct ScreenShake {
+    float time = 0.f;
+    float duration = 0.20f;
+    float magnitude = 6.f;
+};
 
-// --- particles (add-only) ---
-struct Particle {
-    sf::Vector2f pos{ 0.f, 0.f };
-    sf::Vector2f vel{ 0.f, 0.f };
-    float life = 0.f;
+// --- fixed-step scheduler ---
+// Real time is banked in whole microseconds and spent in ticks of sim.delayMs, so
+// the remainder carries over to the next frame and several ticks can run in one
+// frame. After a long stall (window drag, breakpoint) at most MAX_CATCHUP ticks
+// are replayed and the rest of the backlog is dropped.
+struct TickScheduler {
+    static constexpr int MAX_CATCHUP = 8;
+    sf::Int64 banked = 0;
+
+    static sf::Int64 period(int delayMs) { return std::max<sf::Int64>(1, sf::Int64(delayMs) * 1000); }
+
+    void add(sf::Time elapsed) { banked += elapsed.asMicroseconds(); }
+    // Takes one tick's worth of banked time if there is enough.
+    bool take(int delayMs) {
+        sf::Int64 p = period(delayMs);
+        if (banked < p) return false;
+        banked -= p;
+        return true;
+    }
+    void clamp(int delayMs) { banked = std::min(banked, period(delayMs) * MAX_CATCHUP); }
+    void reset() { banked = 0; }
 };
 
-std::vector<Particle> particles;
+// Turbo: ignore sim.delayMs and step for about this long each frame, so only every
+// Kth state (K = ticks that fit in the budget) reaches the screen.
+constexpr float TURBO_FRAME_BUDGET = 0.012f;
 
-void spawnParticles(sf::Vector2f center, int count) {
-    particles.reserve(particles.size() + count);
-    for (int i = 0; i < count; ++i) {
-        Particle p{};
-        p.pos = center;
-        p.vel = { frand(-80.f, 80.f), frand(-120.f, -30.f) };
-        p.life = frand(0.18f, 0.35f);
-        particles.push_back(p);
-    }
+static float frand(Rng& rng, float a, float b) {
+    return rng.uniform(a, b);
 }
 
-void updateParticles(float dt) {
-    for (auto& p : particles) {
-        p.life -= dt;
-        p.vel.y += 260.f * dt;
-        p.pos += p.vel * dt;
-    }
-    particles.erase(std::remove_if(particles.begin(), particles.end(),
-        [](const Particle& p) { return p.life <= 0.f; }), particles.end());
-}
+// --- particles (ParticlePool.h) ---
+constexpr int PARTICLES_PER_FOOD = 1800;
+constexpr int PARTICLES_PER_BONUS = 2800;
+constexpr int PARTICLES_PER_CRASH = 4000;
+constexpr float PARTICLE_SIZE = 4.f;   // px square
 
 // Maintains aspect ratio by letterboxing the view into the window
 void letterbox(sf::View& view, unsigned winW, unsigned winH) {
@@ -127,47 +105,95 @@ void letterbox(sf::View& view, unsigned winW, unsigned winH) {
     view.setViewport({ posX, posY, sizeX, sizeY });
 }
 
-sf::Vector2f gridToPixel(sf::Vector2i cell) {
+sf::Vector2f gridToPixel(Cell cell) {
     return {
         float(cell.x * CELL_SIZE),
         float(cell.y * CELL_SIZE + MARGIN)
     };
 }
 
+// Appends one cell-sized quad to a sf::Quads array, `inset` pixels in from each
+// edge, showing the texture rectangle `tex` (none for a flat colour).
+static void appendCellQuad(sf::VertexArray& va, Cell cell, sf::Color color,
+    sf::FloatRect tex = sf::FloatRect(), float inset = 0.f) {
+    const sf::Vector2f p = gridToPixel(cell);
+    const float a = inset, b = float(CELL_SIZE) - inset;
+    const float tx0 = tex.left, ty0 = tex.top, tx1 = tex.left + tex.width, ty1 = tex.top + tex.height;
+    va.append(sf::Vertex(sf::Vector2f(p.x + a, p.y + a), color, sf::Vector2f(tx0, ty0)));
+    va.append(sf::Vertex(sf::Vector2f(p.x + b, p.y + a), color, sf::Vector2f(tx1, ty0)));
+    va.append(sf::Vertex(sf::Vector2f(p.x + b, p.y + b), color, sf::Vector2f(tx1, ty1)));
+    va.append(sf::Vertex(sf::Vector2f(p.x + a, p.y + b), color, sf::Vector2f(tx0, ty1)));
+}
 
-// --- safer spawn helper (FIX) ---
-template <typename BlockedFn>
-sf::Vector2i generateFreeCell(
-    int minx, int maxx, int miny, int maxy,
-    BlockedFn isBlocked,
-    int maxTries = 5000
-) {
-    for (int tries = 0; tries < maxTries; ++tries) {
-        sf::Vector2i p;
-        p.x = minx + rand() % (maxx - minx + 1);
-        p.y = miny + rand() % (maxy - miny + 1);
-        if (!isBlocked(p)) return p;
+// The snake as a GPU-side ring of quads mirroring the body ring: ring slot s is
+// vertices 4s..4s+3. A tick only writes the slot of the new head; the tail costs no
+// upload at all, because only the live slots (tailSlot() round to headSlot(), one or
+// two ranges) are drawn, so shrink food's double pop just shortens the range. The
+// per-frame upload is the ticks since the last frame whatever the snake's length.
+// Anything that rewrites the body wholesale (new game, replay) calls invalidate().
+class SnakeMesh {
+public:
+    // false when the driver has no vertex buffers; draw with a VertexArray then
+    bool create(int capacity) {
+        if (!sf::VertexBuffer::isAvailable() || !buffer.create(std::size_t(capacity) * 4)) return false;
+        slots = capacity;
+        return true;
+    }
+
+    void invalidate() { rebuild = true; }
+    void onStep() { ++pending; }
+
+    // Uploads the quads of the segments pushed since the last sync.
+    void sync(const SnakeBody& body) {
+        int n = (rebuild || pending >= std::int64_t(slots)) ? body.size() : int(std::min<std::int64_t>(pending, body.size()));
+        rebuild = false;
+        pending = 0;
+        tail = body.tailSlot();
+        live = body.size();
+        if (n == 0) return;
+
+        // newest n segments, oldest first, so they land in ring order from `start`
+        const int start = (body.headSlot() - n + 1 + slots) % slots;
+        staging.clear();
+        for (int i = n - 1; i >= 0; --i) appendCellQuad(staging, body[i], sf::Color::Green);
+        const int firstRun = std::min(n, slots - start);
+        buffer.update(&staging[0], std::size_t(firstRun) * 4, unsigned(start) * 4);
+        if (firstRun < n) buffer.update(&staging[std::size_t(firstRun) * 4], std::size_t(n - firstRun) * 4, 0);
     }
-    for (int y = miny; y <= maxy; ++y)
-        for (int x = minx; x <= maxx; ++x) {
-            sf::Vector2i p{ x, y };
-            if (!isBlocked(p)) return p;
-        }
-    return { minx, miny };
-}
 
-// legacy helper (still used in some places; safe if only snake check needed)
-sf::Vector2i generateFoodPosition(
-    const std::deque<sf::Vector2i>& snake,
-    int minx = 1, int maxx = WIDTH - 2,
-    int miny = 1, int maxy = HEIGHT - 2
-) {
-    sf::Vector2i pos;
-    do {
-        pos.x = minx + rand() % (maxx - minx + 1);
-        pos.y = miny + rand() % (maxy - miny + 1);
-    } while (std::find(snake.begin(), snake.end(), pos) != snake.end());
-    return pos;
+    void draw(sf::RenderTarget& target) const {
+        const int firstRun = std::min(live, slots - tail);
+        target.draw(buffer, std::size_t(tail) * 4, std::size_t(firstRun) * 4);
+        if (firstRun < live) target.draw(buffer, 0, std::size_t(live - firstRun) * 4);
+    }
+
+private:
+    sf::VertexBuffer buffer{ sf::Quads, sf::VertexBuffer::Stream };
+    sf::VertexArray staging{ sf::Quads };
+    int slots = 0;
+    int tail = 0;
+    int live = 0;
+    std::int64_t pending = 0;
+    bool rebuild = true;
+};
+
+// --pack when given, else assets.pak in the working directory, else next to the
+// executable; nullptr (loose files) if none of them is a pack.
+static std::unique_ptr<AssetPack> openAssetPack(const std::string& requested, const char* argv0) {
+    std::vector<std::string> tries;
+    if (!requested.empty()) tries.push_back(requested);
+    else {
+        tries.push_back("assets.pak");
+        std::string exe = argv0 ? argv0 : "";
+        std::size_t slash = exe.find_last_of("/\\");
+        if (slash != std::string::npos) tries.push_back(exe.substr(0, slash + 1) + "assets.pak");
+    }
+    for (const std::string& path : tries) {
+        std::unique_ptr<AssetPack> pack(new AssetPack(path));
+        if (pack->valid()) return pack;
+    }
+    if (!requested.empty()) std::cerr << requested << ": not an asset pack, using loose files\n";
+    return nullptr;
 }
 
 int loadHighScore() {
@@ -187,11 +213,6 @@ std::vector<int> loadHighScores() {
     return scores;
 }
 
-#if __has_include(<filesystem>)
-#include <filesystem>
-namespace fs = std::filesystem;
-#endif
-
 static void ensureTxtFolderExists() {
 #if __has_include(<filesystem>)
     try {
@@ -222,102 +243,54 @@ void insertHighScore(std::vector<int>& scores, int score) {
     if (scores.size() > 5) scores.resize(5);
 }
 
-void resetGame(std::deque<sf::Vector2i>& snake,
-    Direction& dir,
-    int& score,
-    int& foodEaten,
-    float& delay,
-    sf::Vector2i& food,
-    bool& bonusActive,
-    float& bonusTimeLeft,
-    int& level,
-    bool& shrinkFoodActive,
-    sf::Vector2i& shrinkFood) {
-    snake = { {10, 15}, {9, 15}, {8, 15} };
-    dir = Right;
-    score = 0;
-    foodEaten = 0;
-    delay = INITIAL_DELAY;
-    warningActive = false;
-    warningCount = 0;
-    warningClock.restart();
-    bonusActive = false;
-    bonusTimeLeft = 0.f;
-    shrinkFood = { -1, -1 };
-    food = generateFoodPosition(snake);
-    (void)level;
-    (void)shrinkFoodActive;
-}
-
-void generateObstacles(int level,
-    const std::deque<sf::Vector2i>& snake,
-    std::vector<sf::Vector2i>& obstacles) {
-    obstacles.clear();
-    int count = (level == 2 ? 5 : 10);
-    for (int i = 0; i < count; ++i) {
-        sf::Vector2i p;
-        do {
-            p.x = rand() % (WIDTH - 2) + 1;
-            p.y = rand() % (HEIGHT - 2) + 1;
-        } while (std::find(snake.begin(), snake.end(), p) != snake.end());
-        obstacles.push_back(p);
-    }
-}
-
-bool shrinkFoodActive = false;
-sf::Vector2i shrinkFood{ -1, -1 };
-
-void doLevelSetup(int lvl,
-    const std::deque<sf::Vector2i>& snake,
-    std::vector<sf::Vector2i>& obstacles) {
-    shrinkFoodActive = (lvl == 2 || lvl == 3);
-
-    if (lvl >= 2) {
-        shrinkFood = generateFoodPosition(snake);
-        generateObstacles(lvl, snake, obstacles);
-    }
-    else {
-        obstacles.clear();
-        shrinkFood = { -1, -1 };
-    }
-
-    if (lvl == 3) {
-        enemies.clear();
-        Enemy e;
-
-        int ix0 = 1, ix1 = WIDTH - 2, iy0 = 1, iy1 = HEIGHT - 2;
-
-        do {
-            e.pos.x = ix0 + rand() % (ix1 - ix0 + 1);
-            e.pos.y = iy0 + rand() % (iy1 - iy0 + 1);
-        } while (std::find(obstacles.begin(), obstacles.end(), e.pos) != obstacles.end()
-            || std::find(snake.begin(), snake.end(), e.pos) != snake.end());
-
-        enemies.push_back(e);
-
-        shrinkTicks = 0;
-        nextShrinkFood = SHRINK_FOOD_STEP;
-        warningActive = false;
-        warningCount = 0;
-        warningClock.restart();
-
-        // enemy animation reset (FIX)
-        enemyAnimClock.restart();
-    }
-}
-
-void showFlashMessage(sf::RenderWindow& w, sf::Font& f, const std::string& txt, float seconds) {
-    sf::Text t(txt, f, 48);
-    t.setFillColor(sf::Color::Yellow);
+void showFlashMessage(sf::RenderWindow& w, const GlyphAtlas& glyphs, const std::string& txt, float seconds) {
+    HudText t(glyphs, 48, sf::Color::Yellow);
+    t.setString(txt);
     auto b = t.getLocalBounds();
     t.setPosition((WIDTH * CELL_SIZE - b.width) / 2, MARGIN + 20);
-    w.draw(t);
+    sf::VertexArray quads(sf::Quads);
+    t.appendTo(quads);
+    w.draw(quads, &glyphs.texture());
     w.display();
     sf::sleep(sf::seconds(seconds));
 }
 
-int main() {
-    srand(static_cast<unsigned int>(time(nullptr)));
+// SnakeGame [--replay file]   the replay is shown in real time instead of playing
+//           [--swarm n]       level 3 spawns n enemies instead of one
+//           [--fade seconds]  music crossfade time, 0 for hard cuts
+int main(int argc, char** argv) {
+    const std::uint64_t seed = std::uint64_t(time(nullptr));
+
+    std::unique_ptr<MappedFile> replayFile;
+    ReplayReader replayReader;
+    int swarmSize = 1;
+    bool hugeMode = false;
+    int hugeSide = HUGE_WORLD_SIDE;
+    std::string packPath;
+    float musicFade = 0.75f;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string opt = argv[i];
+        if (opt == "--replay") {
+            replayFile.reset(new MappedFile(argv[i + 1]));
+            replayReader = ReplayReader(replayFile->data(), replayFile->size());
+            if (!replayReader.valid()) std::cerr << argv[i + 1] << ": not a replay, starting normally\n";
+        }
+        else if (opt == "--swarm") {
+            swarmSize = std::max(0, std::min(MAX_ENEMIES, std::atoi(argv[i + 1])));
+        }
+        else if (opt == "--huge") {
+            hugeMode = true;
+            hugeSide = std::atoi(argv[i + 1]);
+        }
+        else if (opt == "--pack") {
+            packPath = argv[i + 1];
+        }
+        else if (opt == "--fade") {
+            musicFade = std::max(0.f, float(std::atof(argv[i + 1])));
+        }
+    }
+    const std::unique_ptr<AssetPack> assets = openAssetPack(packPath, argc > 0 ? argv[0] : nullptr);
+    const AssetPack* pack = assets.get();
 
     static constexpr unsigned LOG_W = WIDTH * CELL_SIZE;
     static constexpr unsigned LOG_H = HEIGHT * CELL_SIZE + MARGIN;
@@ -346,58 +319,72 @@ int main() {
 
     window.setVerticalSyncEnabled(vsyncEnabled);
 
-    // Music
-    sf::Music menuMusic;
-    if (!menuMusic.openFromFile("audios/music.ogg"))
+    // Music: every track stays pre-rolled, and screen changes crossfade
+    MusicDirector music;
+    music.setFadeTime(musicFade);
+    music.setVolume(musicVolume);
+    if (!music.open(TrackMenu, pack, "audios/music.ogg", true))
         std::cerr << "Error loading audios/music.ogg\n";
-    menuMusic.setLoop(true);
-    menuMusic.setVolume(musicVolume);
-
-    sf::Music gameMusic;
-    if (!gameMusic.openFromFile("audios/gameplay.ogg"))
+    if (!music.open(TrackGame, pack, "audios/gameplay.ogg", true))
         std::cerr << "Error loading audios/gameplay.ogg\n";
-    gameMusic.setLoop(true);
-    gameMusic.setVolume(musicVolume);
-
-    sf::Music gameOverMusic;
-    if (!gameOverMusic.openFromFile("audios/gameover.ogg"))
+    if (!music.open(TrackGameOver, pack, "audios/gameover.ogg", false))
         std::cerr << "Error loading audios/gameover.ogg\n";
-    gameOverMusic.setLoop(false);
-    gameOverMusic.setVolume(musicVolume);
 
-    sf::Music CrashMusic;
-    if (!CrashMusic.openFromFile("audios/crash.ogg"))
-        std::cerr << "Error loading audios/crash.ogg\n";
-    CrashMusic.setLoop(false);
-    CrashMusic.setVolume(sfxVolume);
+    // Sound effects; eating many apples a second in late turbo games is capped per
+    // clip rather than starting a voice per event. The clips are decoded by the asset
+    // loader below, and only games play them, which wait for the loader first.
+    SfxPlayer sfx;
+    sfx.setLimits(SfxEat, 0.05f, 3, 0);
+    sfx.setLimits(SfxBonus, 0.08f, 2, 1);
+    sfx.setLimits(SfxLevelUp, 0.25f, 1, 2);
+    sfx.setLimits(SfxCrash, 0.25f, 1, 3);
+    sfx.setVolume(sfxVolume);
 
-    menuMusic.play();
+    music.play(TrackMenu);
 
     sf::Font font;
-    if (!font.loadFromFile("fonts/snake.ttf")) {
+    if (!loadFont(pack, "fonts/snake.ttf", font)) {
         std::cerr << "Failed to load fonts/snake.ttf\n";
         return -1;
     }
 
-    sf::Texture wallTex;
-    wallTex.loadFromFile("images/wall.png");
-
-    sf::Texture foodTex;
-    sf::Sprite foodSprite;
-    sf::Texture ShrinkFoodTex;
-    sf::Sprite ShrinkFoodSprite;
-    sf::Texture enemySheet;
-    sf::Texture bonusFoodTex;
-    sf::Sprite bonusFoodSprite;
-
-    if (!enemySheet.loadFromFile("images/enemy.png")) { std::cerr << "images/enemy.png load fail\n"; return -1; }
-    if (!foodTex.loadFromFile("images/Apple.png")) { std::cerr << "images/Apple.png load fail\n"; return -1; }
-    if (!ShrinkFoodTex.loadFromFile("images/bad.png")) { std::cerr << "images/bad.png load fail\n"; return -1; }
-    if (!bonusFoodTex.loadFromFile("images/Bonus.png")) { std::cerr << "images/Bonus.png load fail\n"; return -1; }
+    // HUD text is drawn from glyphs baked once, at the sizes it uses; the menus keep
+    // their long-lived sf::Texts. Baking needs the GL thread, so it waits until the
+    // menu is up and the background loads are done (ensureGlyphs); the screens that
+    // show HUD text make sure of it first.
+    GlyphAtlas glyphs(font);
+    glyphs.bake(16);                      // score, info line, bonus timer
+    glyphs.bake(20);                      // hints
+    glyphs.bake(36, "0123456789. ");      // high-score rows
+    glyphs.bake(48);                      // titles, flash messages
+    glyphs.bake(96, "0123456789");        // level-3 countdown
+    sf::VertexArray hudQuads(sf::Quads);
+
+    HudText hsTitle(glyphs, 48, sf::Color::Yellow);
+    std::vector<HudText> hsRows(5, HudText(glyphs, 36));
+    for (size_t i = 0; i < hsRows.size(); ++i) hsRows[i].setPosition(100, 140 + float(i) * 50.f);
+    HudText hsHint(glyphs, 20);
+    std::vector<int> hsShown{ -1 };
+
+    bool glyphsReady = false;
+    auto ensureGlyphs = [&]() {
+        if (glyphsReady) return;
+        if (!glyphs.build()) std::cerr << "Error building the glyph atlas\n";
+        glyphsReady = true;
+        // fixed strings are laid out once the glyphs exist
+        hsTitle.setString("HIGH SCORES");
+        hsTitle.setPosition((WIDTH * CELL_SIZE - hsTitle.getLocalBounds().width) / 2, 50);
+        hsHint.setString("Press ESC or 0 to return");
+        hsHint.setPosition(60, HEIGHT * CELL_SIZE + MARGIN - 40);
+    };
 
+    // The menu needs only the font and its background, so those load here and
+    // everything else is decoded on worker threads while the menu is already up.
+    // Finished images are uploaded from the frame loop (installReady), and starting
+    // a game waits for whatever is still missing (waitForAssets).
     sf::Texture menuBgTex;
     sf::Sprite  menuBgSprite;
-    if (!menuBgTex.loadFromFile("images/menu_bg.png")) { std::cerr << "images/menu_bg.png load fail\n"; return -1; }
+    if (!loadTexture(pack, "images/menu_bg.png", menuBgTex)) { std::cerr << "images/menu_bg.png load fail\n"; return -1; }
     menuBgSprite.setTexture(menuBgTex);
 
     float windowWidth = float(WIDTH * CELL_SIZE);
@@ -407,79 +394,142 @@ int main() {
     menuBgSprite.setScale(windowWidth / texWidth, windowHeight / texHeight);
     menuBgSprite.setPosition(0.f, 0.f);
 
-    std::vector<sf::Texture> levelBgTex;
-    std::vector<sf::Sprite>  levelBgSprite;
-    sf::Texture gameOverBgTex;
-    sf::Sprite  gameOverBgSprite;
-
     int numLevels = 3;
-    levelBgTex.resize(numLevels);
-    levelBgSprite.resize(numLevels);
-
-    for (int i = 0; i < numLevels; ++i) {
-        std::string filename = "images/level" + std::to_string(i + 1) + "_bg.png";
-        if (!levelBgTex[i].loadFromFile(filename)) {
-            std::cerr << "Failed to load " << filename << "\n";
-            return -1;
-        }
-        levelBgSprite[i].setTexture(levelBgTex[i]);
-       
-       float sx = float(WIDTH * CELL_SIZE) / float(levelBgTex[i].getSize().x);
-        float sy = float(HEIGHT * CELL_SIZE + MARGIN) / float(levelBgTex[i].getSize().y);
-
-        levelBgSprite[i].setScale(sx, sy);
-        levelBgSprite[i].setPosition(0, 0);
-    }
-
-    if (!gameOverBgTex.loadFromFile("images/gameover_bg.png")) {
-        std::cerr << "Failed to load images/gameover_bg.png\n";
-        return -1;
-    }
-    gameOverBgSprite.setTexture(gameOverBgTex);
+    auto levelBgName = [](int i) { return "images/level" + std::to_string(i + 1) + "_bg.png"; };
+    const std::vector<std::string> spriteImages = {
+        "images/wall.png", "images/Apple.png", "images/bad.png", "images/Bonus.png", "images/enemy.png"
+    };
+    AssetLoader loader(pack);
     {
-        float sx2 = float(WIDTH * CELL_SIZE) / gameOverBgTex.getSize().x;
-        float sy2 = float(HEIGHT * CELL_SIZE + MARGIN) / gameOverBgTex.getSize().y;
-        gameOverBgSprite.setScale(sx2, sy2);
-        gameOverBgSprite.setPosition(0, 0);
+        std::vector<std::string> names = spriteImages;
+        for (int i = 0; i < numLevels; ++i) names.push_back(levelBgName(i));
+        names.push_back("images/gameover_bg.png");
+        loader.start(names, {
+            [&sfx, pack] {
+                if (!sfx.load(SfxCrash, pack, "audios/crash.ogg"))
+                    std::cerr << "Error loading audios/crash.ogg\n";
+            },
+            [&sfx] {
+                sfx.synthesize(SfxEat, { 880.f, 1320.f }, 0.035f);
+                sfx.synthesize(SfxBonus, { 660.f, 990.f, 1320.f }, 0.045f);
+                sfx.synthesize(SfxLevelUp, { 523.f, 659.f, 784.f, 1047.f }, 0.07f);
+            },
+        });
     }
 
-    foodTex.setSmooth(true);
-    ShrinkFoodTex.setSmooth(true);
-    bonusFoodTex.setSmooth(true);
-
-    foodSprite.setTexture(foodTex);
-    ShrinkFoodSprite.setTexture(ShrinkFoodTex);
-    bonusFoodSprite.setTexture(bonusFoodTex);
-
-    foodSprite.setScale(float(CELL_SIZE - 4) / foodTex.getSize().x,
-        float(CELL_SIZE - 4) / foodTex.getSize().y);
-    foodSprite.setOrigin(foodTex.getSize().x / 2.f, foodTex.getSize().y / 2.f);
-
-    ShrinkFoodSprite.setScale(float(CELL_SIZE - 4) / ShrinkFoodTex.getSize().x,
-        float(CELL_SIZE - 4) / ShrinkFoodTex.getSize().y);
-    ShrinkFoodSprite.setOrigin(ShrinkFoodTex.getSize().x / 2.f, ShrinkFoodTex.getSize().y / 2.f);
-
-    bonusFoodSprite.setScale(float(CELL_SIZE - 4) / bonusFoodTex.getSize().x,
-        float(CELL_SIZE - 4) / bonusFoodTex.getSize().y);
-    bonusFoodSprite.setOrigin(bonusFoodTex.getSize().x / 2.f, bonusFoodTex.getSize().y / 2.f);
+    std::vector<sf::Texture> levelBgTex(numLevels);
+    std::vector<sf::Sprite>  levelBgSprite(numLevels);
+    sf::Texture gameOverBgTex;
+    sf::Sprite  gameOverBgSprite;
+    auto fitToScreen = [&](sf::Sprite& sp, const sf::Texture& tex) {
+        if (tex.getSize().x == 0 || tex.getSize().y == 0) return;
+        sp.setTexture(tex, true);
+        sp.setScale(windowWidth / tex.getSize().x, windowHeight / tex.getSize().y);
+        sp.setPosition(0.f, 0.f);
+    };
 
-    enemySheet.setSmooth(false);
+    // The level background, walls and obstacles only change on level setup and when
+    // the ring shrinks, so they are rendered off-screen then and each frame blits the
+    // result as one sprite. Whatever changes them raises staticLayerDirty. Without
+    // render-texture support the layer is drawn straight to the window every frame.
+    sf::RenderTexture staticLayer;
+    const bool staticLayerOk = staticLayer.create(WIDTH * CELL_SIZE, HEIGHT * CELL_SIZE + MARGIN);
+    sf::Sprite staticLayerSprite;
+    if (staticLayerOk) staticLayerSprite.setTexture(staticLayer.getTexture());
+    bool staticLayerDirty = true;
+
+    // Food, walls and enemy frames are downsampled to their on-screen size and packed
+    // into one atlas texture (TextureAtlas.h) once all their images are in; the
+    // full-size images are dropped after.
+    TextureAtlas atlas;
+    const sf::Texture& atlasTex = atlas.texture();
+    std::vector<std::pair<std::string, sf::Image>> spriteSources;
+    int wallId = 0, foodId = 0, shrinkFoodId = 0, bonusFoodId = 0, enemyFrame0 = 0, flatId = 0;
+    bool atlasReady = false;   // entry ids are only valid once buildAtlas has run
+    sf::FloatRect wallRect, flatRect;
+    sf::Sprite foodSprite, ShrinkFoodSprite, bonusFoodSprite;
+
+    // every enemy shares the current animation frame, so the swarm is one textured
+    // quad per enemy in a single draw call
+    sf::VertexArray enemyQuads(sf::Quads);
+
+    // Walls and obstacles are one draw with the atlas: the outer ring is built once
+    // and the level-3 inner ring and the obstacles (the atlas's flat texel) are
+    // appended behind it.
+    sf::VertexArray wallQuads(sf::Quads);
+    std::size_t outerWallVertices = 0;
+
+    auto buildAtlas = [&]() {
+        auto source = [&](const char* name) -> const sf::Image& {
+            for (auto& s : spriteSources) if (s.first == name) return s.second;
+            return spriteSources.front().second;   // not reached: every name is queued
+        };
+        wallId = atlas.add(source("images/wall.png"), sf::IntRect(), CELL_SIZE, CELL_SIZE);
+        foodId = atlas.add(source("images/Apple.png"), sf::IntRect(), CELL_SIZE - 4, CELL_SIZE - 4);
+        shrinkFoodId = atlas.add(source("images/bad.png"), sf::IntRect(), CELL_SIZE - 4, CELL_SIZE - 4);
+        bonusFoodId = atlas.add(source("images/Bonus.png"), sf::IntRect(), CELL_SIZE - 4, CELL_SIZE - 4);
+        enemyFrame0 = atlas.addSheet(source("images/enemy.png"), ENEMY_COLS, ENEMY_ROWS, CELL_SIZE, CELL_SIZE);
+        sf::Image flatImg;
+        flatImg.create(4, 4, sf::Color::White);
+        flatId = atlas.add(flatImg, sf::IntRect(), 4, 4);
+        if (!atlas.build()) std::cerr << "sprite atlas build fail\n";
+        spriteSources.clear();
+        atlasReady = true;
+
+        wallRect = atlas.frect(wallId);
+        // one white texel, so flat-coloured quads can share the atlas draw
+        flatRect = sf::FloatRect(atlas.frect(flatId).left + 2.f, atlas.frect(flatId).top + 2.f, 0.f, 0.f);
+
+        const std::pair<sf::Sprite*, int> sprites[] = {
+            { &foodSprite, foodId }, { &ShrinkFoodSprite, shrinkFoodId }, { &bonusFoodSprite, bonusFoodId }
+        };
+        for (const auto& sp : sprites) {
+            sp.first->setTexture(atlasTex);
+            sp.first->setTextureRect(atlas.rect(sp.second));
+            sp.first->setOrigin((CELL_SIZE - 4) / 2.f, (CELL_SIZE - 4) / 2.f);
+        }
 
-    int frameW = enemySheet.getSize().x / ENEMY_COLS;
-    int frameH = enemySheet.getSize().y / ENEMY_ROWS;
+        for (int x = 0; x < WIDTH; ++x) {
+            appendCellQuad(wallQuads, { x, 0 }, sf::Color::White, wallRect);
+            appendCellQuad(wallQuads, { x, HEIGHT - 1 }, sf::Color::White, wallRect);
+        }
+        for (int y = 1; y < HEIGHT - 1; ++y) {
+            appendCellQuad(wallQuads, { 0, y }, sf::Color::White, wallRect);
+            appendCellQuad(wallQuads, { WIDTH - 1, y }, sf::Color::White, wallRect);
+        }
+        outerWallVertices = wallQuads.getVertexCount();
+    };
 
-    sf::Sprite enemySprite(enemySheet);
-    enemySprite.setScale(float(CELL_SIZE) / float(frameW),
-        float(CELL_SIZE) / float(frameH));
+    // GPU upload of one decoded image; this thread only. Backgrounds and the atlas
+    // both feed the static layer, so it is redrawn after each one.
+    auto installImage = [&](LoadedImage& img) {
+        staticLayerDirty = true;
+        if (img.name == "images/gameover_bg.png") {
+            if (img.ok && gameOverBgTex.loadFromImage(img.image)) fitToScreen(gameOverBgSprite, gameOverBgTex);
+            return;
+        }
+        for (int i = 0; i < numLevels; ++i) {
+            if (img.name != levelBgName(i)) continue;
+            if (img.ok && levelBgTex[i].loadFromImage(img.image)) fitToScreen(levelBgSprite[i], levelBgTex[i]);
+            return;
+        }
+        // a sprite image; one that failed to load stays empty and shows as nothing
+        spriteSources.emplace_back(img.name, std::move(img.image));
+        if (spriteSources.size() == spriteImages.size()) buildAtlas();
+    };
+    auto installReady = [&]() {
+        for (LoadedImage& img : loader.takeReady()) installImage(img);
+        if (loader.finished()) ensureGlyphs();
+    };
+    auto waitForAssets = [&]() {
+        for (LoadedImage& img : loader.takeAll()) installImage(img);
+        ensureGlyphs();
+    };
 
-    sf::RectangleShape wall(sf::Vector2f(CELL_SIZE, CELL_SIZE));
-    wall.setTexture(&wallTex);
+    sf::VertexArray tileQuads(sf::Quads);   // the snake, without vertex buffers
 
-    // Prebuild outer wall cells (perf)
-    std::vector<sf::Vector2i> outerWalls;
-    outerWalls.reserve(WIDTH * 2 + HEIGHT * 2);
-    for (int x = 0; x < WIDTH; ++x) { outerWalls.push_back({ x, 0 }); outerWalls.push_back({ x, HEIGHT - 1 }); }
-    for (int y = 1; y < HEIGHT - 1; ++y) { outerWalls.push_back({ 0, y }); outerWalls.push_back({ WIDTH - 1, y }); }
+    SnakeMesh snakeMesh;
+    const bool snakeMeshOk = snakeMesh.create(SnakeBody().capacity());
 
     // Pause menu texts
     sf::Text pauseContinue, pauseQuit, pauseToMenu;
@@ -503,12 +553,12 @@ int main() {
     pauseQuit.setPosition(baseX, baseY + 40);
     pauseToMenu.setPosition(baseX, baseY + 80);
 
-    sf::Text bonusTimerText("", font, 16);
-    bonusTimerText.setFillColor(sf::Color::Blue);
+    HudText bonusTimerText(glyphs, 16, sf::Color::Blue);
     bonusTimerText.setPosition(WIDTH * CELL_SIZE - 140, 5);
 
     sf::Text pausedText("GAME PAUSED", font, 48);
     pausedText.setFillColor(sf::Color::White);
+    pausedText.setPosition((WIDTH * CELL_SIZE - pausedText.getLocalBounds().width) / 2, 100);
 
     sf::Text finalScoreText("", font, 28);
     finalScoreText.setFillColor(sf::Color::Yellow);
@@ -538,18 +588,95 @@ int main() {
     sf::RectangleShape bonusShape(sf::Vector2f(CELL_SIZE, CELL_SIZE));
     bonusShape.setFillColor(sf::Color::Blue);
 
-    std::vector<sf::Vector2i> obstacles;
-
-    std::deque<sf::Vector2i> snake;
-    Direction dir;
-    int score, foodEaten;
-    float delay;
-    bool bonusActive;
-    float bonusTimeLeft;
-    sf::Vector2i food, bonusFood;
-    int level = 1;
-
-    resetGame(snake, dir, score, foodEaten, delay, food, bonusActive, bonusTimeLeft, level, shrinkFoodActive, shrinkFood);
+    // all per-game state lives here, not in globals
+    SnakeSim sim;   // set up by resetGame() below
+    sim.swarmSize = swarmSize;
+    Rng fx(seed, 1);   // particles and shake only, so effects never change the game
+    PlayMode playMode = PickLevel;
+
+    // --- enemy animation clock (FIX) ---
+    sf::Clock enemyAnimClock;
+
+    ScreenShake shake;
+    ParticlePool particles;
+    sf::VertexArray particleQuads(sf::Quads);
+
+    // level setup restarts the enemy animation too (FIX)
+    TickScheduler ticker;
+    bool turbo = false;
+
+    // Mood menu option: the built-in bot steers instead of the arrow keys
+    Autopilot pilot;
+    bool autopilot = false;
+
+    // --huge: the chunked world replaces the board; it is drawn through a camera on
+    // the head, visible chunks only, in one atlas-textured vertex array
+    HugeWorld world(hugeSide);
+    world.seed(seed);
+    world.newGame();
+    sf::VertexArray hugeQuads(sf::Quads);
+
+    // every game gets its own seed and is recorded; the last one is saved on death
+    std::uint64_t gamesStarted = 0;
+    ReplayRecorder recorder;
+    ReplayPlayer replayer;
+    bool replaying = false;
+
+    // Every reset of the board goes through here, so the snake mesh and the replay
+    // log always describe the game on screen: a fresh, recorded game on the current
+    // level and mode, played at once by New Game or left behind the menu by Quit.
+    auto resetGame = [&]() {
+        std::uint64_t gameSeed = seed + gamesStarted++;
+        sim.seed(gameSeed);
+        recorder.begin(gameSeed, sim.level, playMode, sim.swarmSize);
+        sim.newGame(playMode);
+        pilot.reset();
+        replaying = false;
+        staticLayerDirty = true;
+        snakeMesh.invalidate();
+        ticker.reset();
+        enemyAnimClock.restart();
+    };
+    resetGame();
+    auto startNewGame = [&]() {
+        waitForAssets();
+        if (hugeMode) {
+            world.seed(seed + gamesStarted++);
+            world.newGame();
+            ticker.reset();
+            return;
+        }
+        resetGame();
+    };
+    auto startReplay = [&]() {
+        waitForAssets();
+        replayer.start(replayReader, sim);
+        replaying = true;
+        staticLayerDirty = true;
+        snakeMesh.invalidate();
+        ticker.reset();
+        enemyAnimClock.restart();
+    };
+    // Level / mode choice from the menus. It starts over through resetGame(), so the
+    // board left behind the menu is one newGame() built and the replay header names.
+    auto pickLevel = [&](int lvl, PlayMode mode) {
+        sim.level = lvl;
+        playMode = mode;
+        resetGame();
+    };
+    // background, outer walls, inner wall (level 3 shrink) darkened, obstacles
+    auto drawStaticLayer = [&](sf::RenderTarget& target) {
+        target.draw(levelBgSprite[sim.level - 1]);
+
+        wallQuads.resize(outerWallVertices);
+        sim.plane(CellInnerWall).forEach([&](int i) {
+            appendCellQuad(wallQuads, cellAt(i), sf::Color(100, 100, 100), wallRect);
+        });
+        sim.obstacles().forEach([&](int i) {
+            appendCellQuad(wallQuads, cellAt(i), sf::Color(128, 64, 0), flatRect);
+        });
+        target.draw(wallQuads, &atlasTex);
+    };
 
     GameState state = Paused;
     MenuState menu = MainMenu;
@@ -579,6 +706,28 @@ int main() {
     pickText.setPosition(pickBtn.getPosition().x + 10,
         pickBtn.getPosition().y + (pickBtn.getSize().y - pickText.getCharacterSize()) / 2 - 5);
 
+    sf::RectangleShape autoBtn({ 260, 48 });
+    autoBtn.setFillColor({ 80, 80, 80 });
+    autoBtn.setOutlineThickness(2);
+    autoBtn.setOutlineColor(sf::Color::White);
+    autoBtn.setPosition(60, 270);
+
+    sf::Text autoText("3. Autopilot: Off", font, 28);
+    autoText.setFillColor(sf::Color::White);
+    autoText.setPosition(autoBtn.getPosition().x + 10,
+        autoBtn.getPosition().y + (autoBtn.getSize().y - autoText.getCharacterSize()) / 2 - 5);
+
+    auto steer = [&](Direction d) {
+        if (hugeMode) world.steer(d);
+        else sim.steer(d);
+    };
+
+    auto toggleAutopilot = [&]() {
+        autopilot = !autopilot;
+        pilot.reset();
+        autoText.setString(autopilot ? "3. Autopilot: On" : "3. Autopilot: Off");
+    };
+
     // PickLevel menu buttons
     std::array<sf::RectangleShape, 3> levelBtns;
     std::array<sf::Text, 3> levelLabels;
@@ -628,17 +777,19 @@ int main() {
     }
 
     // Cached score text (FIX)
-    sf::Text scoreText("", font, 16);
-    scoreText.setFillColor(sf::Color::White);
+    HudText scoreText(glyphs, 16);
     scoreText.setPosition(5.f, 5.f);
 
-    sf::Text infoText("", font, 16);
-    infoText.setFillColor(sf::Color::White);
+    HudText infoText(glyphs, 16);
     infoText.setPosition(5.f, 22.f);
 
+    HudText warningText(glyphs, 96, sf::Color::Red);
+
     int lastScoreShown = INT_MIN;
     int lastLevelShown = -1;
     PlayMode lastModeShown = PickLevel;
+    bool lastTurboShown = false;
+    bool lastAutoShown = false;
 
     // --- Settings menu UI (add-only) ---
     sf::Text settingsTitle("SETTINGS", font, 48);
@@ -707,12 +858,92 @@ int main() {
     backHint.setFillColor(sf::Color::White);
     backHint.setPosition(60.f, HEIGHT * CELL_SIZE + MARGIN - 40);
 
+    if (replayReader.valid()) {
+        hugeMode = false;   // replays are of board games
+        startReplay();
+        state = Playing;
+        menu = InGame;
+        music.play(TrackGame);
+    }
+
+    // particles are in board / world coordinates, so they follow whichever view is set
+    auto drawParticles = [&]() {
+        const int n = particles.size();
+        particleQuads.resize(std::size_t(n) * 4);
+        for (int i = 0; i < n; ++i) {
+            float a = std::max(0.f, std::min(1.f, particles.life[i] / PARTICLE_MAX_LIFE));
+            sf::Color c(255, 255, 255, sf::Uint8(255 * a));
+            float x = particles.x[i], y = particles.y[i];
+            sf::Vertex* q = &particleQuads[std::size_t(i) * 4];
+            q[0] = sf::Vertex(sf::Vector2f(x, y), c);
+            q[1] = sf::Vertex(sf::Vector2f(x + PARTICLE_SIZE, y), c);
+            q[2] = sf::Vertex(sf::Vector2f(x + PARTICLE_SIZE, y + PARTICLE_SIZE), c);
+            q[3] = sf::Vertex(sf::Vector2f(x, y + PARTICLE_SIZE), c);
+        }
+        if (n > 0) window.draw(particleQuads);
+    };
+
+    auto drawGameOver = [&](int finalScore) {
+        window.draw(gameOverBgSprite);
+
+        finalScoreText.setString("Score: " + std::to_string(finalScore));
+        finalScoreText.setPosition((WIDTH * CELL_SIZE - finalScoreText.getLocalBounds().width) / 2,
+            HEIGHT * CELL_SIZE / 2 - 30);
+        window.draw(finalScoreText);
+
+        int topHighScore = highScores.empty() ? 0 : highScores[0];
+        highScoreText.setString("High Score: " + std::to_string(topHighScore));
+        highScoreText.setPosition((WIDTH * CELL_SIZE - highScoreText.getLocalBounds().width) / 2,
+            HEIGHT * CELL_SIZE / 2 + 10);
+        window.draw(highScoreText);
+
+        float btnY = HEIGHT * CELL_SIZE / 2 + 60;
+        float spacing = 20.f;
+        float totalWidth = restartBtn.getSize().x + exitBtn.getSize().x + spacing;
+        float btnY_dash = HEIGHT * CELL_SIZE / 2 + 140;
+
+        restartBtn.setPosition((WIDTH * CELL_SIZE - totalWidth) / 2, btnY);
+        exitBtn.setPosition((WIDTH * CELL_SIZE - totalWidth) / 2 + restartBtn.getSize().x + spacing, btnY);
+        menuBtn.setPosition((WIDTH * CELL_SIZE - menuBtn.getSize().x) / 2, btnY_dash);
+
+        bool flash = ((int)(flashClock.getElapsedTime().asSeconds() * 2)) % 2 == 0;
+        sf::Color borderColor = flash ? sf::Color::White : sf::Color::Transparent;
+        restartBtn.setOutlineColor(borderColor);
+        exitBtn.setOutlineColor(borderColor);
+
+        window.draw(restartBtn);
+        window.draw(exitBtn);
+        window.draw(menuBtn);
+
+        // center texts
+        sf::FloatRect rt = restartText.getLocalBounds();
+        restartText.setOrigin(rt.left + rt.width / 2.f, rt.top + rt.height / 2.f);
+        restartText.setPosition(restartBtn.getPosition().x + restartBtn.getSize().x / 2.f,
+            restartBtn.getPosition().y + restartBtn.getSize().y / 2.f);
+
+        sf::FloatRect et = exitText.getLocalBounds();
+        exitText.setOrigin(et.left + et.width / 2.f, et.top + et.height / 2.f);
+        exitText.setPosition(exitBtn.getPosition().x + exitBtn.getSize().x / 2.f,
+            exitBtn.getPosition().y + exitBtn.getSize().y / 2.f);
+
+        menuText.setPosition(menuBtn.getPosition().x + 10,
+            menuBtn.getPosition().y + (menuBtn.getSize().y - menuText.getCharacterSize()) / 2 - 5);
+
+        window.draw(restartText);
+        window.draw(exitText);
+        window.draw(menuText);
+    };
+
     // --- game loop ---
     while (window.isOpen()) {
-        float dt = clock.restart().asSeconds();
+        sf::Time frameTime = clock.restart();
+        float dt = frameTime.asSeconds();
+
+        installReady();
+        music.update(dt);
 
         // update particles always
-        updateParticles(dt);
+        particles.update(dt);
 
         sf::Event e;
         while (window.pollEvent(e)) {
@@ -762,6 +993,7 @@ int main() {
                 else if (menu == MoodMenu) {
                     cycleBtn.setFillColor(cycleBtn.getGlobalBounds().contains(mp) ? hover : sf::Color(80, 80, 80));
                     pickBtn.setFillColor(pickBtn.getGlobalBounds().contains(mp) ? hover : sf::Color(80, 80, 80));
+                    autoBtn.setFillColor(autoBtn.getGlobalBounds().contains(mp) ? hover : sf::Color(80, 80, 80));
                 }
                 else if (menu == PickLevelMenu) {
                     for (int i = 0; i < MAX_LEVEL; ++i) {
@@ -788,10 +1020,8 @@ int main() {
                     if (draggingSfx)   setVolFromBar(sfxBar, sfxVolume);
 
                     // Apply live
-                    menuMusic.setVolume(musicVolume);
-                    gameMusic.setVolume(musicVolume);
-                    gameOverMusic.setVolume(musicVolume);
-                    CrashMusic.setVolume(sfxVolume);
+                    music.setVolume(musicVolume);
+                    sfx.setVolume(sfxVolume);
                 }
             }
 
@@ -802,22 +1032,18 @@ int main() {
                 if (menu == MainMenu) {
                     if (menuTexts[0].getGlobalBounds().contains(mp)) {
                         if (state == Playing || state == Paused) {
+                            waitForAssets();
                             menu = InGame;
-                            menuMusic.stop();
-                            gameMusic.play();
+                            music.play(TrackGame);
                         }
                     }
                     else if (menuTexts[1].getGlobalBounds().contains(mp)) {
                         // New Game
-                        resetGame(snake, dir, score, foodEaten, delay, food, bonusActive, bonusTimeLeft, level, shrinkFoodActive, shrinkFood);
-                        if (playMode == CycleLevel) level = 1;
-                        nextShrinkFood = SHRINK_FOOD_STEP;
-                        doLevelSetup(level, snake, obstacles);
+                        startNewGame();
 
                         state = Playing;
                         menu = InGame;
-                        menuMusic.stop();
-                        gameMusic.play();
+                        music.play(TrackGame);
                     }
                     else if (menuTexts[2].getGlobalBounds().contains(mp)) {
                         menu = HighScoreMenu;
@@ -838,28 +1064,25 @@ int main() {
 
                 else if (menu == MoodMenu) {
                     if (cycleBtn.getGlobalBounds().contains(mp)) {
-                        playMode = CycleLevel;
-                        level = 1;
-                        shrinkFoodActive = false;
-                        obstacles.clear();
+                        pickLevel(1, CycleLevel);
                         menu = MainMenu;
-                        gameMusic.stop();
-                        menuMusic.play();
+                        music.play(TrackMenu);
                     }
                     else if (pickBtn.getGlobalBounds().contains(mp)) {
                         menu = PickLevelMenu;
                     }
+                    else if (autoBtn.getGlobalBounds().contains(mp)) {
+                        toggleAutopilot();
+                    }
                     // (Mouse union bug FIX: no e.key usage here)
                 }
 
                 else if (menu == PickLevelMenu) {
                     for (int i = 0; i < MAX_LEVEL; ++i) {
                         if (levelBtns[i].getGlobalBounds().contains(mp)) {
-                            level = i + 1;
-                            doLevelSetup(level, snake, obstacles);
+                            pickLevel(i + 1, PickLevel);
                             menu = MainMenu;
-                            gameMusic.stop();
-                            menuMusic.play();
+                            music.play(TrackMenu);
                         }
                     }
                 }
@@ -868,46 +1091,33 @@ int main() {
                     if (pauseContinue.getGlobalBounds().contains(mp)) {
                         state = Playing;
                         menu = InGame;
-                        menuMusic.stop();
-                        gameMusic.play();
+                        music.play(TrackGame);
                     }
                     else if (pauseQuit.getGlobalBounds().contains(mp)) {
                         window.close();
                     }
                     else if (pauseToMenu.getGlobalBounds().contains(mp)) {
-                        resetGame(snake, dir, score, foodEaten, delay, food, bonusActive, bonusTimeLeft, level, shrinkFoodActive, shrinkFood);
+                        resetGame();
                         menu = MainMenu;
-                        gameMusic.stop();
-                        menuMusic.play();
+                        music.play(TrackMenu);
                         state = Paused;
                     }
                 }
 
                 else if (menu == InGame && state == GameOver) {
                     if (restartBtn.getGlobalBounds().contains(mp)) {
-                        resetGame(snake, dir, score, foodEaten, delay, food, bonusActive, bonusTimeLeft, level, shrinkFoodActive, shrinkFood);
-                        if (playMode == CycleLevel) level = 1;
-                        nextShrinkFood = SHRINK_FOOD_STEP;
-                        doLevelSetup(level, snake, obstacles);
-
-                        warningActive = false;
-                        warningCount = 0;
-                        warningClock.restart();
+                        startNewGame();
 
                         state = Playing;
                         menu = InGame;
-                        gameOverMusic.stop();
-                        menuMusic.stop();
-                        gameMusic.play();
+                        music.play(TrackGame);
                     }
                     else if (exitBtn.getGlobalBounds().contains(mp)) {
                         window.close();
                     }
                     else if (menuBtn.getGlobalBounds().contains(mp)) {
                         menu = MainMenu;
-                        gameOverMusic.stop();
-                        gameMusic.stop();
-                        menuMusic.play();
+                        music.play(TrackMenu);
                         state = Paused;
                     }
                 }
@@ -957,21 +1167,17 @@ int main() {
                     case sf::Keyboard::Num1:
                     case sf::Keyboard::Numpad1:
                         if (state == Playing || state == Paused) {
+                            waitForAssets();
                             menu = InGame;
-                            menuMusic.stop();
-                            gameMusic.play();
+                            music.play(TrackGame);
                         }
                         break;
                     case sf::Keyboard::Num2:
                     case sf::Keyboard::Numpad2:
-                        resetGame(snake, dir, score, foodEaten, delay, food, bonusActive, bonusTimeLeft, level, shrinkFoodActive, shrinkFood);
-                        if (playMode == CycleLevel) level = 1;
-                        nextShrinkFood = SHRINK_FOOD_STEP;
-                        doLevelSetup(level, snake, obstacles);
+                        startNewGame();
                         state = Playing;
                         menu = InGame;
-                        menuMusic.stop();
-                        gameMusic.play();
+                        music.play(TrackGame);
                         break;
                     case sf::Keyboard::Num3:
                     case sf::Keyboard::Numpad3:
@@ -1009,15 +1215,15 @@ int main() {
                         menu = MainMenu;
                     }
                     else if (e.key.code == sf::Keyboard::Num1 || e.key.code == sf::Keyboard::Numpad1) {
-                        playMode = CycleLevel;
-                        level = 1;
-                        shrinkFoodActive = false;
-                        obstacles.clear();
+                        pickLevel(1, CycleLevel);
                         menu = MainMenu;
                     }
                     else if (e.key.code == sf::Keyboard::Num2 || e.key.code == sf::Keyboard::Numpad2) {
                         menu = PickLevelMenu;
                     }
+                    else if (e.key.code == sf::Keyboard::Num3 || e.key.code == sf::Keyboard::Numpad3) {
+                        toggleAutopilot();
+                    }
                 }
 
                 else if (menu == PickLevelMenu) {
@@ -1025,13 +1231,13 @@ int main() {
                         menu = MainMenu;
                     }
                     else if (e.key.code == sf::Keyboard::Num1 || e.key.code == sf::Keyboard::Numpad1) {
-                        level = 1; doLevelSetup(level, snake, obstacles); menu = MainMenu;
+                        pickLevel(1, PickLevel); menu = MainMenu;
                     }
                     else if (e.key.code == sf::Keyboard::Num2 || e.key.code == sf::Keyboard::Numpad2) {
-                        level = 2; doLevelSetup(level, snake, obstacles); menu = MainMenu;
+                        pickLevel(2, PickLevel); menu = MainMenu;
                     }
                     else if (e.key.code == sf::Keyboard::Num3 || e.key.code == sf::Keyboard::Numpad3) {
-                        level = 3; doLevelSetup(level, snake, obstacles); menu = MainMenu;
+                        pickLevel(3, PickLevel); menu = MainMenu;
                     }
                 }
 
@@ -1047,36 +1253,37 @@ int main() {
 
                 else if (menu == InGame) {
                     if (state == Playing) {
-                        if (e.key.code == sf::Keyboard::Up && dir != Down) dir = Up;
-                        else if (e.key.code == sf::Keyboard::Down && dir != Up) dir = Down;
-                        else if (e.key.code == sf::Keyboard::Left && dir != Right) dir = Left;
-                        else if (e.key.code == sf::Keyboard::Right && dir != Left) dir = Right;
+                        if ((replaying || (autopilot && !hugeMode)) && e.key.code >= sf::Keyboard::Left && e.key.code <= sf::Keyboard::Down) {
+                            // arrow keys do nothing while a replay or the autopilot drives the snake
+                            // (the autopilot only plays the board)
+                        }
+                        else if (e.key.code == sf::Keyboard::Up) steer(Up);
+                        else if (e.key.code == sf::Keyboard::Down) steer(Down);
+                        else if (e.key.code == sf::Keyboard::Left) steer(Left);
+                        else if (e.key.code == sf::Keyboard::Right) steer(Right);
+                        else if (e.key.code == sf::Keyboard::T) {
+                            turbo = !turbo;
+                            ticker.reset();
+                        }
                         else if (e.key.code == sf::Keyboard::P) {
                             state = Paused;
-                            gameMusic.pause();
+                            music.pause();
                             menu = PauseMenu;
                         }
                     }
                     else if (state == Paused) {
                         if (e.key.code == sf::Keyboard::P) {
                             state = Playing;
-                            gameMusic.play();
+                            music.resume();
                             menu = InGame;
                         }
                     }
                     else if (state == GameOver) {
                         if (e.key.code == sf::Keyboard::R) {
-                            resetGame(snake, dir, score, foodEaten, delay, food, bonusActive, bonusTimeLeft, level, shrinkFoodActive, shrinkFood);
-                            if (playMode == CycleLevel) level = 1;
-                            nextShrinkFood = SHRINK_FOOD_STEP;
-                            doLevelSetup(level, snake, obstacles);
-                            warningActive = false;
-                            warningCount = 0;
-                            warningClock.restart();
+                            startNewGame();
                             state = Playing;
                             menu = InGame;
-                            gameOverMusic.stop();
-                            gameMusic.play();
+                            music.play(TrackGame);
                         }
                         else if (e.key.code == sf::Keyboard::Escape) {
                             window.close();
@@ -1084,9 +1291,7 @@ int main() {
                         else if (e.key.code == sf::Keyboard::M) {
                             menu = MainMenu;
                             state = Paused;
-                            gameOverMusic.stop();
-                            gameMusic.stop();
-                            menuMusic.play();
+                            music.play(TrackMenu);
                         }
                     }
                 }
@@ -1094,16 +1299,15 @@ int main() {
                 else if (menu == PauseMenu) {
                     if (e.key.code == sf::Keyboard::P || e.key.code == sf::Keyboard::Num1 || e.key.code == sf::Keyboard::Numpad1) {
                         state = Playing;
-                        gameMusic.play();
+                        music.resume();
                         menu = InGame;
                     }
                     else if (e.key.code == sf::Keyboard::Num2 || e.key.code == sf::Keyboard::Numpad2) {
                         window.close();
                     }
                     else if (e.key.code == sf::Keyboard::Num3 || e.key.code == sf::Keyboard::Numpad3) {
-                        resetGame(snake, dir, score, foodEaten, delay, food, bonusActive, bonusTimeLeft, level, shrinkFoodActive, shrinkFood);
-                        gameMusic.stop();
-                        menuMusic.play();
+                        resetGame();
+                        music.play(TrackMenu);
                         menu = MainMenu;
                         state = Paused;
                     }
@@ -1113,253 +1317,107 @@ int main() {
 
         // --- apply screen shake to view before drawing ---
         sf::View shaken = baseView;
-        if (shakeTime > 0.f) {
-            shakeTime -= dt;
-            float strength = std::max(0.f, shakeTime / shakeDuration);
-            float dx = frand(-shakeMagnitude, shakeMagnitude) * strength;
-            float dy = frand(-shakeMagnitude, shakeMagnitude) * strength;
+        if (shake.time > 0.f) {
+            shake.time -= dt;
+            float strength = std::max(0.f, shake.time / shake.duration);
+            float dx = frand(fx, -shake.magnitude, shake.magnitude) * strength;
+            float dy = frand(fx, -shake.magnitude, shake.magnitude) * strength;
             shaken.move(dx, dy);
         }
         window.setView(shaken);
 
         // --- game update ---
         if (menu == InGame && state == Playing) {
-            static float timer = 0.f;
-            timer += dt;
-
-            if (timer >= delay) {
-                timer = 0.f;
-
-                sf::Vector2i head = snake.front();
-                if (dir == Up) head.y--;
-                else if (dir == Down) head.y++;
-                else if (dir == Left) head.x--;
-                else if (dir == Right) head.x++;
-
-                // level 3 enemy movement + collision vs NEW head (FIX)
-                if (level == 3) {
-                    minX = shrinkTicks + 1; maxX = WIDTH - 2 - shrinkTicks;
-                    minY = shrinkTicks + 1; maxY = HEIGHT - 2 - shrinkTicks;
-
-                    for (auto& en : enemies) {
-                        en.moveTimer += dt;
-                        if (en.moveTimer >= en.moveDelay) {
-                            en.moveTimer = 0.f;
-
-                            std::vector<sf::Vector2i> nbs;
-                            static const sf::Vector2i dirs4[4] = { {1,0},{-1,0},{0,1},{0,-1} };
-                            for (auto& d4 : dirs4) {
-                                sf::Vector2i np = en.pos + d4;
-
-                                if (np.x < 1 || np.x > WIDTH - 2 || np.y < 1 || np.y > HEIGHT - 2) continue;
-                                if (np.x <= minX || np.x >= maxX || np.y <= minY || np.y >= maxY) continue;
-
-                                if (std::find(obstacles.begin(), obstacles.end(), np) != obstacles.end()) continue;
-                                if (std::find(snake.begin(), snake.end(), np) != snake.end()) continue;
-
-                                nbs.push_back(np);
-                            }
-                            if (!nbs.empty()) en.pos = nbs[rand() % nbs.size()];
-                        }
-
-                        if (head == en.pos) {
-                            CrashMusic.stop();
-                            CrashMusic.setVolume(sfxVolume);
-                            CrashMusic.play();
-                            shakeTime = shakeDuration;
-
-                            state = GameOver;
-                            gameOverMusic.play();
-                            gameMusic.stop();
-                            break;
-                        }
-                    }
-                    if (state == GameOver) {
-                        // record score
-                        insertHighScore(highScores, score);
-                        saveHighScores(highScores);
-                        if (score > loadHighScore()) saveHighScore(score);
-                    }
-                    if (state == GameOver) goto DRAW_FRAME;
-                }
-
-                // bounds for inner walls
-                minX = shrinkTicks + 1; maxX = WIDTH - 2 - shrinkTicks;
-                minY = shrinkTicks + 1; maxY = HEIGHT - 2 - shrinkTicks;
-
-                bool hitInnerWall = (level == 3 && shrinkTicks > 0) &&
-                    ((head.x == minX) || (head.x == maxX) || (head.y == minY) || (head.y == maxY));
-
-                bool hitOuterWall = (head.x == 0 || head.x == WIDTH - 1 || head.y == 0 || head.y == HEIGHT - 1);
-                bool hitObstacle = std::find(obstacles.begin(), obstacles.end(), head) != obstacles.end();
-                bool hitSelf = std::find(snake.begin(), snake.end(), head) != snake.end();
-
-                if (hitInnerWall || hitOuterWall || hitSelf || hitObstacle) {
-                    insertHighScore(highScores, score);
-                    saveHighScores(highScores);
-                    if (score > loadHighScore()) saveHighScore(score);
-
-                    CrashMusic.stop();
-                    CrashMusic.setVolume(sfxVolume);
-                    CrashMusic.play();
-                    shakeTime = shakeDuration;
-
-                    state = GameOver;
-                    gameOverMusic.play();
-                    gameMusic.stop();
-                    menu = InGame;
-                    goto DRAW_FRAME;
-                }
-
-                // warning countdown -> shrink
-                if (warningActive) {
-                    if (warningClock.getElapsedTime().asSeconds() >= 1.f) {
-                        warningClock.restart();
-                        --warningCount;
-                        if (warningCount == 0) {
-                            shrinkTicks++;
-                            nextShrinkFood += SHRINK_FOOD_STEP;
-                            warningActive = false;
-
-                            int newMinX = shrinkTicks + 1;
-                            int newMaxX = WIDTH - 2 - shrinkTicks;
-                            int newMinY = shrinkTicks + 1;
-                            int newMaxY = HEIGHT - 2 - shrinkTicks;
-
-                            for (auto& en : enemies) {
-                                if (en.pos.x < newMinX || en.pos.x > newMaxX || en.pos.y < newMinY || en.pos.y > newMaxY) {
-                                    sf::Vector2i dest;
-                                    do {
-                                        dest.x = newMinX + rand() % (newMaxX - newMinX + 1);
-                                        dest.y = newMinY + rand() % (newMaxY - newMinY + 1);
-                                    } while (std::find(snake.begin(), snake.end(), dest) != snake.end()
-                                        || std::find(obstacles.begin(), obstacles.end(), dest) != obstacles.end());
-                                    en.pos = dest;
-                                }
-                            }
-
-                            auto count = obstacles.size();
-                            obstacles.erase(std::remove_if(obstacles.begin(), obstacles.end(),
-                                [&](const sf::Vector2i& o) {
-                                    return o.x < newMinX || o.x > newMaxX || o.y < newMinY || o.y > newMaxY;
-                                }), obstacles.end());
-
-                            while (obstacles.size() < count) {
-                                obstacles.push_back(generateFoodPosition(snake, newMinX, newMaxX, newMinY, newMaxY));
-                            }
-                        }
+            // One tick's side effects; returns false once the game is over.
+            auto onTick = [&](const StepResult& r) {
+                snakeMesh.onStep();
+                sf::Vector2f eatenPixel = gridToPixel(r.eatenAt) + sf::Vector2f(CELL_SIZE / 2.f, CELL_SIZE / 2.f);
+
+                // particles on eat / bonus
+                if (r.has(EvAteFood)) particles.burst(fx, eatenPixel.x, eatenPixel.y, PARTICLES_PER_FOOD);
+                if (r.has(EvAteBonus)) particles.burst(fx, eatenPixel.x, eatenPixel.y, PARTICLES_PER_BONUS);
+                if (r.has(EvAteFood)) sfx.play(SfxEat, fx.uniform(0.94f, 1.08f));
+                if (r.has(EvAteBonus)) sfx.play(SfxBonus);
+                if (r.has(EvLevelUp)) sfx.play(SfxLevelUp);
+
+                if (r.has(EvLevelUp) || r.has(EvShrunk)) staticLayerDirty = true;
+
+                if (r.has(EvLevelUp)) {
+                    enemyAnimClock.restart();
+                    if (!turbo) {
+                        showFlashMessage(window, glyphs, "LEVEL UP!", 1.0f);
+                        // the flash blocks; don't bank that second as ticks to catch up on
+                        ticker.reset();
+                        clock.restart();
                     }
                 }
 
-                snake.push_front(head);
-
-                // compute spawn bounds
-                int fx0 = (level == 3 ? minX + 1 : 1);
-                int fx1 = (level == 3 ? maxX - 1 : WIDTH - 2);
-                int fy0 = (level == 3 ? minY + 1 : 1);
-                int fy1 = (level == 3 ? maxY - 1 : HEIGHT - 2);
-
-                auto blocked = [&](sf::Vector2i p) {
-                    if (std::find(snake.begin(), snake.end(), p) != snake.end()) return true;
-                    if (std::find(obstacles.begin(), obstacles.end(), p) != obstacles.end()) return true;
-                    if (level == 3) {
-                        for (auto& en : enemies) if (en.pos == p) return true;
-                        if (shrinkTicks > 0) {
-                            int minX2 = shrinkTicks + 1, maxX2 = WIDTH - 2 - shrinkTicks;
-                            int minY2 = shrinkTicks + 1, maxY2 = HEIGHT - 2 - shrinkTicks;
-                            if (p.x == minX2 || p.x == maxX2 || p.y == minY2 || p.y == maxY2) return true;
+                if (r.has(EvDied)) {
+                    // huge-world games are neither recorded nor ranked
+                    if (!replaying && !hugeMode) {
+                        // bot games are recorded but stay off the high-score table
+                        if (!autopilot) {
+                            insertHighScore(highScores, sim.score);
+                            saveHighScores(highScores);
+                            if (sim.score > loadHighScore()) saveHighScore(sim.score);
                         }
-                    }
-                    return false;
-                    };
-
-                if (head == food) {
-                    score += 10;
-                    foodEaten++;
-
-                    // particles on eat
-                    spawnParticles(gridToPixel(food) + sf::Vector2f(CELL_SIZE / 2.f, CELL_SIZE / 2.f), 18);
-
-                    if (level < MAX_LEVEL && score >= LEVEL_UP_SCORES[level]) {
-                        level++;
-                        doLevelSetup(level, snake, obstacles);
-                        showFlashMessage(window, font, "LEVEL UP!", 1.0f);
-                    }
-
-                    food = generateFreeCell(fx0, fx1, fy0, fy1, blocked);
-
-                    if (level == 2 || level == 3) {
-                        shrinkFood = generateFreeCell(fx0, fx1, fy0, fy1, blocked);
-                    }
 
-                    if (level == 3 && !warningActive && shrinkTicks < MAX_SHRINK_TICKS && foodEaten >= nextShrinkFood) {
-                        warningActive = true;
-                        warningCount = 3;
-                        warningClock.restart();
+                        recorder.finish(sim.score);
+                        ensureTxtFolderExists();
+                        recorder.save("txt/last_game.replay");
                     }
 
-                    if (foodEaten % FOODS_PER_LEVEL == 0 && !bonusActive) {
-                        bonusActive = true;
-                        bonusTimeLeft = BONUS_TIME;
-                        bonusFood = generateFreeCell(fx0, fx1, fy0, fy1, blocked);
+                    // eating the last bit of shrink food ends the game quietly
+                    if (!r.has(EvAteShrink)) {
+                        sfx.play(SfxCrash);
+                        shake.time = shake.duration;
+                        sf::Vector2f headPixel = gridToPixel(hugeMode ? world.snake.front() : sim.snake.front())
+                            + sf::Vector2f(CELL_SIZE / 2.f, CELL_SIZE / 2.f);
+                        particles.burst(fx, headPixel.x, headPixel.y, PARTICLES_PER_CRASH);
                     }
 
-                    delay = std::max(MIN_DELAY, delay - DELAY_DECREMENT);
+                    state = GameOver;
+                    music.play(TrackGameOver);
+                    menu = InGame;
+                    return false;
                 }
-                else if (bonusActive && head == bonusFood) {
-                    score += static_cast<int>(BONUS_MAX_SCORE * (bonusTimeLeft / BONUS_TIME));
-                    bonusActive = false;
-
-                    // particles on bonus
-                    spawnParticles(gridToPixel(bonusFood) + sf::Vector2f(CELL_SIZE / 2.f, CELL_SIZE / 2.f), 28);
-
-                    if (level < MAX_LEVEL && score >= LEVEL_UP_SCORES[level]) {
-                        level++;
-                        doLevelSetup(level, snake, obstacles);
-                        showFlashMessage(window, font, "LEVEL UP!", 1.0f);
-                    }
-
-                    if (level == 3 && shrinkTicks < MAX_SHRINK_TICKS && foodEaten >= nextShrinkFood) {
-                        warningActive = true;
-                        warningCount = 3;
-                        warningClock.restart();
-                    }
+                return true;
+            };
+
+            auto stepOnce = [&]() -> StepResult {
+                if (hugeMode) return world.step();
+                if (!replaying) {
+                    if (autopilot) sim.steer(pilot.decide(sim));
+                    recorder.record(sim.dir);
+                    return sim.step();
                 }
-                else if (shrinkFoodActive && head == shrinkFood) {
-                    if (snake.size() <= STARTING_SNAKE_LENGTH + 1) {
-                        insertHighScore(highScores, score);
-                        saveHighScores(highScores);
-                        if (score > loadHighScore()) saveHighScore(score);
-
-                        state = GameOver;
-                        gameOverMusic.play();
-                        gameMusic.stop();
-                        menu = InGame;
-                        goto DRAW_FRAME;
-                    }
-                    else {
-                        snake.pop_back();
-                        snake.pop_back();
-                        score -= 5;
-                    }
-
-                    food = generateFreeCell(fx0, fx1, fy0, fy1, blocked);
-                    if (level == 2 || level == 3) {
-                        shrinkFood = generateFreeCell(fx0, fx1, fy0, fy1, blocked);
-                    }
+                if (replayer.finished(sim)) {
+                    // the log stops here (recorded games always end in a death)
+                    sim.gameOver = true;
+                    StepResult end;
+                    end.events = EvDied | EvAteShrink;   // ends without the crash effects
+                    return end;
                 }
-                else {
-                    snake.pop_back();
+                return replayer.step(sim);
+            };
+
+            if (turbo) {
+                sf::Clock budget;
+                bool alive = true;
+                while (alive && budget.getElapsedTime().asSeconds() < TURBO_FRAME_BUDGET) {
+                    for (int k = 0; k < 64 && alive; ++k) alive = onTick(stepOnce());
                 }
             }
-
-            if (bonusActive) {
-                bonusTimeLeft -= dt;
-                if (bonusTimeLeft <= 0) bonusActive = false;
+            else {
+                const int& delayMs = hugeMode ? world.delayMs : sim.delayMs;
+                ticker.add(frameTime);
+                ticker.clamp(delayMs);
+                while (ticker.take(delayMs)) {
+                    if (!onTick(stepOnce())) { ticker.reset(); break; }
+                }
             }
         }
 
-    DRAW_FRAME:
         window.clear();
 
         if (menu == MainMenu) {
@@ -1370,26 +1428,23 @@ int main() {
         }
 
         if (menu == HighScoreMenu) {
+            ensureGlyphs();
             sf::RectangleShape bg(sf::Vector2f(WIDTH * CELL_SIZE, HEIGHT * CELL_SIZE + MARGIN));
             bg.setFillColor(sf::Color(20, 20, 60));
             window.draw(bg);
 
-            sf::Text title("HIGH SCORES", font, 48);
-            title.setFillColor(sf::Color::Yellow);
-            title.setPosition((WIDTH * CELL_SIZE - title.getLocalBounds().width) / 2, 50);
-            window.draw(title);
-
-            for (size_t i = 0; i < highScores.size(); ++i) {
-                sf::Text hsItem(std::to_string(i + 1) + ". " + std::to_string(highScores[i]), font, 36);
-                hsItem.setFillColor(sf::Color::White);
-                hsItem.setPosition(100, 140 + float(i) * 50.f);
-                window.draw(hsItem);
+            // rows are laid out again only when the table changed
+            if (highScores != hsShown) {
+                for (size_t i = 0; i < hsRows.size(); ++i)
+                    hsRows[i].setString(i < highScores.size()
+                        ? std::to_string(i + 1) + ". " + std::to_string(highScores[i]) : "");
+                hsShown = highScores;
             }
-
-            sf::Text info("Press ESC or 0 to return", font, 20);
-            info.setFillColor(sf::Color::White);
-            info.setPosition(60, HEIGHT * CELL_SIZE + MARGIN - 40);
-            window.draw(info);
+            hudQuads.clear();
+            hsTitle.appendTo(hudQuads);
+            for (const HudText& row : hsRows) row.appendTo(hudQuads);
+            hsHint.appendTo(hudQuads);
+            window.draw(hudQuads, &glyphs.texture());
 
             window.display();
             continue;
@@ -1401,6 +1456,8 @@ int main() {
             window.draw(cycleText);
             window.draw(pickBtn);
             window.draw(pickText);
+            window.draw(autoBtn);
+            window.draw(autoText);
             window.display();
             continue;
         }
@@ -1459,7 +1516,7 @@ int main() {
         }
 
         if (menu == PauseMenu) {
-            window.draw(levelBgSprite[level - 1]);
+            window.draw(levelBgSprite[sim.level - 1]);
 
             // fake blur overlay (stacked translucent layers)
             sf::RectangleShape overlay(sf::Vector2f(WIDTH * CELL_SIZE, HEIGHT * CELL_SIZE + MARGIN));
@@ -1475,10 +1532,7 @@ int main() {
             overlay.setPosition(0.f, 0.f);
             window.draw(overlay);
 
-            sf::Text pauseTitle("GAME PAUSED", font, 48);
-            pauseTitle.setFillColor(sf::Color::White);
-            pauseTitle.setPosition((WIDTH * CELL_SIZE - pauseTitle.getLocalBounds().width) / 2, 100);
-            window.draw(pauseTitle);
+            window.draw(pausedText);
 
             window.draw(pauseContinue);
             window.draw(pauseQuit);
@@ -1488,177 +1542,185 @@ int main() {
             continue;
         }
 
-        // InGame (Playing / Paused / GameOver)
-        if (menu == InGame) {
-            window.draw(levelBgSprite[level - 1]);
-
-            // outer walls
-            for (auto& c : outerWalls) {
-                wall.setPosition(gridToPixel(c));
-                window.draw(wall);
+        // Huge world: only the chunks under the camera are looked at, and every cell
+        // drawn goes into the one atlas-textured vertex array, so a frame costs the
+        // visible area however long the snake or big the world is.
+        if (menu == InGame && hugeMode) {
+            window.draw(levelBgSprite[0]);
+
+            const float cs = float(CELL_SIZE);
+            sf::View camera = shaken;
+            camera.setCenter(gridToPixel(world.snake.front()) + sf::Vector2f(cs / 2.f, cs / 2.f)
+                + (shaken.getCenter() - baseView.getCenter()));
+            window.setView(camera);
+
+            // visible cells, with a cell of slack on every side
+            const sf::Vector2f corner = camera.getCenter() - camera.getSize() / 2.f;
+            const int vx0 = int(std::floor(corner.x / cs)) - 1;
+            const int vy0 = int(std::floor((corner.y - MARGIN) / cs)) - 1;
+            const int vx1 = vx0 + int(camera.getSize().x / cs) + 2;
+            const int vy1 = vy0 + int(camera.getSize().y / cs) + 2;
+
+            const sf::FloatRect foodRect = atlasReady ? atlas.frect(foodId) : sf::FloatRect();
+            hugeQuads.clear();
+
+            // the wall is the ring just outside the world
+            const int side = world.side();
+            for (int y = std::max(vy0, -1); y <= std::min(vy1, side); ++y) {
+                for (int x = std::max(vx0, -1); x <= std::min(vx1, side); ++x) {
+                    if (x == -1 || y == -1 || x == side || y == side)
+                        appendCellQuad(hugeQuads, { x, y }, sf::Color::White, wallRect);
+                }
             }
 
-            // inner wall (level 3 shrink)
-            if (level == 3 && shrinkTicks > 0) {
-                wall.setFillColor(sf::Color(100, 100, 100));
-                for (int x = minX; x <= maxX; ++x) {
-                    wall.setPosition(gridToPixel({ x, minY })); window.draw(wall);
-                    wall.setPosition(gridToPixel({ x, maxY })); window.draw(wall);
+            const ChunkMap& map = world.world();
+            const int cx0 = std::max(vx0, 0) >> CHUNK_SHIFT, cx1 = std::min(vx1, side - 1) >> CHUNK_SHIFT;
+            const int cy0 = std::max(vy0, 0) >> CHUNK_SHIFT, cy1 = std::min(vy1, side - 1) >> CHUNK_SHIFT;
+            for (int cy = cy0; cy <= cy1; ++cy) {
+                for (int cx = cx0; cx <= cx1; ++cx) {
+                    const WorldChunk* k = map.find(cx, cy);
+                    if (!k) continue;   // never touched: nothing there
+                    const int x0 = std::max(vx0, cx << CHUNK_SHIFT), x1 = std::min(vx1, (cx << CHUNK_SHIFT) + CHUNK_SIDE - 1);
+                    const int y0 = std::max(vy0, cy << CHUNK_SHIFT), y1 = std::min(vy1, (cy << CHUNK_SHIFT) + CHUNK_SIDE - 1);
+                    for (int y = y0; y <= y1; ++y) {
+                        for (int x = x0; x <= x1; ++x) {
+                            std::uint8_t t = k->at(x & (CHUNK_SIDE - 1), y & (CHUNK_SIDE - 1));
+                            if (t & CellSnake) appendCellQuad(hugeQuads, { x, y }, sf::Color::Green, flatRect);
+                            else if (t & CellObstacle) appendCellQuad(hugeQuads, { x, y }, sf::Color(128, 64, 0), flatRect);
+                            else if (t & CellFood) appendCellQuad(hugeQuads, { x, y }, sf::Color::White, foodRect, 2.f);
+                        }
+                    }
                 }
-                for (int y = minY; y <= maxY; ++y) {
-                    wall.setPosition(gridToPixel({ minX, y })); window.draw(wall);
-                    wall.setPosition(gridToPixel({ maxX, y })); window.draw(wall);
+            }
+            appendCellQuad(hugeQuads, world.snake.front(), sf::Color(180, 255, 120), flatRect);
+
+            window.draw(hugeQuads, &atlasTex);
+            drawParticles();
+
+            // HUD in screen space
+            window.setView(shaken);
+            if (world.score != lastScoreShown) {
+                scoreText.setString("Score: " + std::to_string(world.score));
+                lastScoreShown = world.score;
+            }
+            infoText.setString("World: " + std::to_string(side) + "x" + std::to_string(side)
+                + "  Length: " + std::to_string(world.snake.size())
+                + "  Chunks: " + std::to_string(map.chunkCount())
+                + " (" + std::to_string(map.memoryBytes() >> 10) + " KB)" + (turbo ? "  TURBO" : ""));
+            hudQuads.clear();
+            scoreText.appendTo(hudQuads);
+            infoText.appendTo(hudQuads);
+            window.draw(hudQuads, &glyphs.texture());
+
+            if (state == GameOver) drawGameOver(world.score);
+
+            window.display();
+            continue;
+        }
+
+        // InGame (Playing / Paused / GameOver)
+        if (menu == InGame) {
+            if (!staticLayerOk) {
+                drawStaticLayer(window);
+            }
+            else {
+                if (staticLayerDirty) {
+                    staticLayer.clear();
+                    drawStaticLayer(staticLayer);
+                    staticLayer.display();
+                    staticLayerDirty = false;
                 }
-                wall.setFillColor(sf::Color::White);
+                window.draw(staticLayerSprite);
             }
 
             // draw enemies (animation clock FIX)
-            if (level == 3) {
+            if (sim.level == 3 && atlasReady) {
                 float elapsed = enemyAnimClock.getElapsedTime().asSeconds();
                 int frameInRow = int(elapsed / ENEMY_FRAME_DURATION) % ENEMY_COLS;
-                int rowIndex = std::min(shrinkTicks, 2);
-
-                enemySprite.setTextureRect({
-                    frameInRow * frameW,
-                    rowIndex * frameH,
-                    frameW,
-                    frameH
-                    });
-
-                for (auto& en : enemies) {
-                    enemySprite.setPosition(gridToPixel(en.pos));
-                    window.draw(enemySprite);
-                }
+                int rowIndex = std::min(sim.shrinkTicks, 2);
 
-                if (warningActive) {
-                    sf::Text warningText(std::to_string(warningCount), font, 96);
-                    warningText.setFillColor(sf::Color::Red);
-                    auto b = warningText.getLocalBounds();
-                    warningText.setOrigin(b.left + b.width / 2, b.top + b.height / 2);
-                    warningText.setPosition(WIDTH * CELL_SIZE / 2.f, (HEIGHT * CELL_SIZE + MARGIN) / 2.f);
-                    window.draw(warningText);
+                const sf::FloatRect frame = atlas.frect(enemyFrame0 + rowIndex * ENEMY_COLS + frameInRow);
+                enemyQuads.clear();
+                for (int i = 0; i < sim.enemies.size(); ++i) {
+                    appendCellQuad(enemyQuads, sim.enemies.pos(i), sf::Color::White, frame);
                 }
+                window.draw(enemyQuads, &atlasTex);
             }
 
-            // food
-            {
-                sf::Vector2f pixel = gridToPixel(food) + sf::Vector2f(CELL_SIZE / 2.f, CELL_SIZE / 2.f);
+            // food (absent only when the board is completely full)
+            if (sim.food.x >= 0) {
+                sf::Vector2f pixel = gridToPixel(sim.food) + sf::Vector2f(CELL_SIZE / 2.f, CELL_SIZE / 2.f);
                 foodSprite.setPosition(pixel);
                 window.draw(foodSprite);
             }
 
             // bonus
-            if (bonusActive) {
-                sf::Vector2f pixel = gridToPixel(bonusFood) + sf::Vector2f(CELL_SIZE / 2.f, CELL_SIZE / 2.f);
+            if (sim.bonusActive) {
+                sf::Vector2f pixel = gridToPixel(sim.bonusFood) + sf::Vector2f(CELL_SIZE / 2.f, CELL_SIZE / 2.f);
                 bonusFoodSprite.setPosition(pixel);
                 window.draw(bonusFoodSprite);
             }
 
-            // obstacles
-            sf::RectangleShape obsShape(sf::Vector2f(CELL_SIZE, CELL_SIZE));
-            obsShape.setFillColor(sf::Color(128, 64, 0));
-            for (auto& o : obstacles) {
-                obsShape.setPosition(gridToPixel(o));
-                window.draw(obsShape);
-            }
-
             // snake
-            sf::RectangleShape segment(sf::Vector2f(CELL_SIZE, CELL_SIZE));
-            segment.setFillColor(sf::Color::Green);
-            for (const auto& s : snake) {
-                segment.setPosition(gridToPixel(s));
-                window.draw(segment);
+            if (snakeMeshOk) {
+                snakeMesh.sync(sim.snake);
+                snakeMesh.draw(window);
+            }
+            else {
+                tileQuads.clear();
+                for (Cell c : sim.snake) appendCellQuad(tileQuads, c, sf::Color::Green);
+                window.draw(tileQuads);
             }
 
             // shrink food
-            if (shrinkFoodActive && shrinkFood != sf::Vector2i{ -1, -1 }) {
-                sf::Vector2f pixel = gridToPixel(shrinkFood) + sf::Vector2f(CELL_SIZE / 2.f, CELL_SIZE / 2.f);
+            if (sim.shrinkFoodActive && sim.shrinkFood != Cell{ -1, -1 }) {
+                sf::Vector2f pixel = gridToPixel(sim.shrinkFood) + sf::Vector2f(CELL_SIZE / 2.f, CELL_SIZE / 2.f);
                 ShrinkFoodSprite.setPosition(pixel);
                 window.draw(ShrinkFoodSprite);
             }
 
-            // particles
-            sf::CircleShape dot(2.f);
-            for (auto& p : particles) {
-                float a = std::max(0.f, std::min(1.f, p.life / 0.35f));
-                dot.setFillColor(sf::Color(255, 255, 255, sf::Uint8(255 * a)));
-                dot.setPosition(p.pos);
-                window.draw(dot);
-            }
+            drawParticles();
 
             // cached score text (FIX)
-            if (score != lastScoreShown) {
-                scoreText.setString("Score: " + std::to_string(score));
-                lastScoreShown = score;
+            if (sim.score != lastScoreShown) {
+                scoreText.setString("Score: " + std::to_string(sim.score));
+                lastScoreShown = sim.score;
             }
-            window.draw(scoreText);
 
-            if (level != lastLevelShown || playMode != lastModeShown) {
+            if (sim.level != lastLevelShown || playMode != lastModeShown || turbo != lastTurboShown || autopilot != lastAutoShown) {
                 std::string mode = (playMode == CycleLevel ? "Cycle" : "Pick");
-                infoText.setString("Level: " + std::to_string(level) + "  Mode: " + mode);
-                lastLevelShown = level;
+                infoText.setString("Level: " + std::to_string(sim.level) + "  Mode: " + mode
+                    + (autopilot ? "  AUTO" : "") + (turbo ? "  TURBO" : ""));
+                lastLevelShown = sim.level;
                 lastModeShown = playMode;
+                lastTurboShown = turbo;
+                lastAutoShown = autopilot;
             }
-            window.draw(infoText);
+
+            // all HUD text goes out in one draw
+            hudQuads.clear();
+            scoreText.appendTo(hudQuads);
+            infoText.appendTo(hudQuads);
 
             // bonus timer
-            if (bonusActive) {
+            if (sim.bonusActive) {
                 std::ostringstream oss;
-                oss << "Bonus: " << std::fixed << std::setprecision(1) << bonusTimeLeft;
+                oss << "Bonus: " << std::fixed << std::setprecision(1) << sim.bonusSecondsLeft();
                 bonusTimerText.setString(oss.str());
-                window.draw(bonusTimerText);
+                bonusTimerText.appendTo(hudQuads);
             }
 
-            if (state == GameOver) {
-                window.draw(gameOverBgSprite);
-
-                finalScoreText.setString("Score: " + std::to_string(score));
-                finalScoreText.setPosition((WIDTH * CELL_SIZE - finalScoreText.getLocalBounds().width) / 2,
-                    HEIGHT * CELL_SIZE / 2 - 30);
-                window.draw(finalScoreText);
-
-                int topHighScore = highScores.empty() ? 0 : highScores[0];
-                highScoreText.setString("High Score: " + std::to_string(topHighScore));
-                highScoreText.setPosition((WIDTH * CELL_SIZE - highScoreText.getLocalBounds().width) / 2,
-                    HEIGHT * CELL_SIZE / 2 + 10);
-                window.draw(highScoreText);
-
-                float btnY = HEIGHT * CELL_SIZE / 2 + 60;
-                float spacing = 20.f;
-                float totalWidth = restartBtn.getSize().x + exitBtn.getSize().x + spacing;
-                float btnY_dash = HEIGHT * CELL_SIZE / 2 + 140;
-
-                restartBtn.setPosition((WIDTH * CELL_SIZE - totalWidth) / 2, btnY);
-                exitBtn.setPosition((WIDTH * CELL_SIZE - totalWidth) / 2 + restartBtn.getSize().x + spacing, btnY);
-                menuBtn.setPosition((WIDTH * CELL_SIZE - menuBtn.getSize().x) / 2, btnY_dash);
-
-                bool flash = ((int)(flashClock.getElapsedTime().asSeconds() * 2)) % 2 == 0;
-                sf::Color borderColor = flash ? sf::Color::White : sf::Color::Transparent;
-                restartBtn.setOutlineColor(borderColor);
-                exitBtn.setOutlineColor(borderColor);
-
-                window.draw(restartBtn);
-                window.draw(exitBtn);
-                window.draw(menuBtn);
-
-                // center texts
-                sf::FloatRect rt = restartText.getLocalBounds();
-                restartText.setOrigin(rt.left + rt.width / 2.f, rt.top + rt.height / 2.f);
-                restartText.setPosition(restartBtn.getPosition().x + restartBtn.getSize().x / 2.f,
-                    restartBtn.getPosition().y + restartBtn.getSize().y / 2.f);
-
-                sf::FloatRect et = exitText.getLocalBounds();
-                exitText.setOrigin(et.left + et.width / 2.f, et.top + et.height / 2.f);
-                exitText.setPosition(exitBtn.getPosition().x + exitBtn.getSize().x / 2.f,
-                    exitBtn.getPosition().y + exitBtn.getSize().y / 2.f);
-
-                menuText.setPosition(menuBtn.getPosition().x + 10,
-                    menuBtn.getPosition().y + (menuBtn.getSize().y - menuText.getCharacterSize()) / 2 - 5);
-
-                window.draw(restartText);
-                window.draw(exitText);
-                window.draw(menuText);
+            // level-3 countdown, centred on the board
+            if (sim.level == 3 && sim.warningActive) {
+                warningText.setString(std::to_string(sim.warningCount));
+                auto b = warningText.getLocalBounds();
+                warningText.setPosition(WIDTH * CELL_SIZE / 2.f - (b.left + b.width / 2),
+                    (HEIGHT * CELL_SIZE + MARGIN) / 2.f - (b.top + b.height / 2));
+                warningText.appendTo(hudQuads);
             }
+            window.draw(hudQuads, &glyphs.texture());
+
+            if (state == GameOver) drawGameOver(sim.score);
 
             window.display();
             continue;
@@ -0,0 +1,259 @@
+// Headless runner: plays games without a window or audio device.
+// Build: g++ -O2 -std=c++17 -pthread SnakeHeadless.cpp SnakeSim.cpp SnakeSimDynamic.cpp SnakeBatch.cpp RolloutRunner.cpp Replay.cpp MappedFile.cpp Autopilot.cpp -o SnakeHeadless
+// (add -mavx2 or -march=native for the vectorized batch path)
+//
+//   SnakeHeadless [games] [level]                      one game at a time
+//   SnakeHeadless board <w> <h> [games] [level]        one game at a time on a w x h board
+//   SnakeHeadless batch [envs] [steps] [level]         lockstep SnakeBatch
+//   SnakeHeadless rollout [episodes] [threads] [level] [enemies]    all cores, work stealing
+//   SnakeHeadless autopilot [episodes] [threads] [level] [enemies]  rollouts driven by the built-in bot
+//   SnakeHeadless record <file> [level] [enemies]      play one game, save its replay
+//   SnakeHeadless replay <file>...                     play replays at full speed, check scores
+
+#include "SnakeSim.h"
+#include "SnakeBatch.h"
+#include "RolloutRunner.h"
+#include "Replay.h"
+#include "Autopilot.h"
+
+#include "Rng.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Cheap stand-in policy: keep going, turn at random now and then.
+template <class B>
+static Direction randomPolicy(const BasicSnakeSim<B>& sim, Rng& rng) {
+    if (rng.below(8) != 0) return sim.dir;
+    return Direction(rng.below(4));
+}
+
+// Same idea for worker threads; the policy stream is separate from the game's.
+struct RandomPolicy : Policy {
+    Rng rng;
+
+    void begin(const SnakeSim&, std::uint64_t seed) override { rng.reseed(seed, 2); }
+    Direction act(const SnakeSim& sim) override { return randomPolicy(sim, rng); }
+};
+
+struct AutopilotPolicy : Policy {
+    Autopilot pilot;
+
+    void begin(const SnakeSim&, std::uint64_t) override { pilot.reset(); }
+    Direction act(const SnakeSim& sim) override { return pilot.decide(sim); }
+};
+
+// Plays `games` random games on whichever board withBoard() picks for w x h.
+static int runBoard(int w, int h, long long games, int level, std::uint64_t seed) {
+    return withBoard(w, h, [&](auto board) {
+        BasicSnakeSim<decltype(board)> sim(board);
+        Rng rng(seed, 2);
+        long long ticks = 0, totalScore = 0;
+
+        auto t0 = std::chrono::steady_clock::now();
+        for (long long g = 0; g < games; ++g) {
+            sim.seed(seed + std::uint64_t(g));
+            sim.level = level;
+            sim.newGame(PickLevel);
+            while (!sim.gameOver) {
+                sim.step(randomPolicy(sim, rng));
+                ++ticks;
+            }
+            totalScore += sim.score;
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        std::cout << "board: " << board.width() << "x" << board.height()
+            << (decltype(board)::FIXED ? " (compiled in)" : " (dynamic)")
+            << "  games: " << games << "  ticks: " << ticks
+            << "  avg score: " << (games ? double(totalScore) / double(games) : 0.0) << "\n";
+        std::cout << "ticks/sec: " << (secs > 0 ? double(ticks) / secs : 0.0) << "\n";
+        return 0;
+    });
+}
+
+static int runRollout(long long episodes, int threads, int level, int enemies, std::uint64_t seed,
+    const PolicyFactory& makePolicy) {
+    WorkStealingPool pool(threads);
+    RolloutConfig cfg;
+    cfg.episodes = episodes;
+    cfg.level = level;
+    cfg.enemies = enemies;
+    cfg.seed = seed;
+
+    auto t0 = std::chrono::steady_clock::now();
+    RolloutStats st = runRollouts(pool, cfg, makePolicy);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "threads: " << pool.threadCount() << "  episodes: " << st.episodes
+        << "  ticks: " << st.ticks
+        << "  avg score: " << (st.episodes ? double(st.totalScore) / double(st.episodes) : 0.0)
+        << "  best: " << st.bestScore << "\n";
+    std::cout << "ticks/sec: " << (secs > 0 ? double(st.ticks) / secs : 0.0) << "\n";
+    return 0;
+}
+
+static int runBatch(int envs, long long steps, int level, std::uint64_t seed) {
+    SnakeBatch batch(envs, level, PickLevel, seed);
+    Rng rng(seed, 2);
+    std::vector<std::uint8_t> actions(envs);
+
+    long long episodes = 0, totalReward = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (long long s = 0; s < steps; ++s) {
+        for (int i = 0; i < envs; ++i) actions[i] = std::uint8_t(randomPolicy(batch.games[i], rng));
+        batch.stepBatch(actions.data());
+        for (int i = 0; i < envs; ++i) {
+            episodes += batch.done[i];
+            totalReward += batch.reward[i];
+        }
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    long long ticks = steps * envs;
+    std::cout << "envs: " << envs << "  steps: " << steps << "  episodes: " << episodes
+        << "  total reward: " << totalReward << "\n";
+    std::cout << "ticks/sec: " << (secs > 0 ? double(ticks) / secs : 0.0) << "\n";
+    return 0;
+}
+
+static int runRecord(const std::string& path, int level, int enemies, std::uint64_t seed) {
+    SnakeSim sim;
+    Rng rng(seed, 2);
+    ReplayRecorder rec;
+
+    sim.seed(seed);
+    sim.level = level;
+    sim.swarmSize = enemies;
+    rec.begin(seed, level, PickLevel, enemies);
+    sim.newGame(PickLevel);
+    while (!sim.gameOver) {
+        sim.steer(randomPolicy(sim, rng));
+        rec.record(sim.dir);
+        sim.step();
+    }
+    rec.finish(sim.score);
+
+    if (!rec.save(path)) {
+        std::cerr << "cannot write " << path << "\n";
+        return 1;
+    }
+    std::cout << path << ": seed " << seed << "  score " << sim.score << "\n";
+    return 0;
+}
+
+static int runReplays(int count, char** paths) {
+    SnakeSim sim;
+    long long ticks = 0;
+    int failed = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < count; ++k) {
+        MappedFile file(paths[k]);
+        ReplayReader reader(file.data(), file.size());
+        if (!reader.valid()) {
+            std::cerr << paths[k] << ": not a replay\n";
+            ++failed;
+            continue;
+        }
+        bool ok = playReplay(reader, sim);
+        ticks += reader.header().ticks;
+        if (!ok) {
+            std::cerr << paths[k] << ": MISMATCH (score " << sim.score << ", recorded "
+                << reader.header().finalScore << ")\n";
+            ++failed;
+        }
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "replays: " << count << "  failed: " << failed << "  ticks: " << ticks << "\n";
+    std::cout << "ticks/sec: " << (secs > 0 ? double(ticks) / secs : 0.0) << "\n";
+    return failed ? 1 : 0;
+}
+
+// Level-3 swarm size argument, clamped to what a game can hold.
+static int enemiesArg(int argc, char** argv, int i) {
+    int n = argc > i ? std::atoi(argv[i]) : 1;
+    return n < 0 ? 0 : (n > MAX_ENEMIES ? MAX_ENEMIES : n);
+}
+
+int main(int argc, char** argv) {
+    const std::uint64_t seed = std::uint64_t(time(nullptr));
+
+    if (argc > 3 && std::string(argv[1]) == "board") {
+        long long games = argc > 4 ? std::atoll(argv[4]) : 1000;
+        int level = argc > 5 ? std::atoi(argv[5]) : 1;
+        if (level < 1 || level > MAX_LEVEL) level = 1;
+        return runBoard(std::atoi(argv[2]), std::atoi(argv[3]), games, level, seed);
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "batch") {
+        int envs = argc > 2 ? std::atoi(argv[2]) : 256;
+        long long steps = argc > 3 ? std::atoll(argv[3]) : 10000;
+        int level = argc > 4 ? std::atoi(argv[4]) : 1;
+        if (envs < 1) envs = 1;
+        if (level < 1 || level > MAX_LEVEL) level = 1;
+        return runBatch(envs, steps, level, seed);
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "rollout") {
+        long long episodes = argc > 2 ? std::atoll(argv[2]) : 100000;
+        int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+        int level = argc > 4 ? std::atoi(argv[4]) : 1;
+        if (level < 1 || level > MAX_LEVEL) level = 1;
+        return runRollout(episodes, threads, level, enemiesArg(argc, argv, 5), seed,
+            [] { return std::unique_ptr<Policy>(new RandomPolicy); });
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "autopilot") {
+        long long episodes = argc > 2 ? std::atoll(argv[2]) : 1000;
+        int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+        int level = argc > 4 ? std::atoi(argv[4]) : 1;
+        if (level < 1 || level > MAX_LEVEL) level = 1;
+        return runRollout(episodes, threads, level, enemiesArg(argc, argv, 5), seed,
+            [] { return std::unique_ptr<Policy>(new AutopilotPolicy); });
+    }
+
+    if (argc > 2 && std::string(argv[1]) == "record") {
+        int level = argc > 3 ? std::atoi(argv[3]) : 1;
+        if (level < 1 || level > MAX_LEVEL) level = 1;
+        return runRecord(argv[2], level, enemiesArg(argc, argv, 4), seed);
+    }
+
+    if (argc > 2 && std::string(argv[1]) == "replay") {
+        return runReplays(argc - 2, argv + 2);
+    }
+
+    long long games = argc > 1 ? std::atoll(argv[1]) : 1000;
+    int level = argc > 2 ? std::atoi(argv[2]) : 1;
+    if (level < 1 || level > MAX_LEVEL) level = 1;
+
+    SnakeSim sim;
+    Rng rng(seed, 2);
+    long long ticks = 0, totalScore = 0;
+    int bestScore = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (long long g = 0; g < games; ++g) {
+        sim.seed(seed + std::uint64_t(g));
+        sim.level = level;
+        sim.newGame(PickLevel);
+        while (!sim.gameOver) {
+            sim.step(randomPolicy(sim, rng));
+            ++ticks;
+        }
+        totalScore += sim.score;
+        if (sim.score > bestScore) bestScore = sim.score;
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "games: " << games << "  ticks: " << ticks
+        << "  avg score: " << (games ? double(totalScore) / double(games) : 0.0)
+        << "  best: " << bestScore << "\n";
+    std::cout << "ticks/sec: " << (secs > 0 ? double(ticks) / secs : 0.0) << "\n";
+    return 0;
+}
@@ -0,0 +1,6 @@
+#include "SnakeSimImpl.h"
+
+template struct BasicSnakeSim<Board<10, 10>>;
+template struct BasicSnakeSim<Board<20, 20>>;
+template struct BasicSnakeSim<DefaultBoard>;
+template struct BasicSnakeSim<Board<64, 64>>;
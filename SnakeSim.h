@@ -0,0 +1,345 @@
+#pragma once
+
+// Headless game rules. Everything in here is plain C++ (no SFML) so games can be
+// stepped without a window or audio device; SnakeGame.cpp is a thin client on top.
+// The rules are written once against a board geometry (Board.h): SnakeSim is the
+// 40x30 window board, BasicSnakeSim<B> any other.
+
+#include <array>
+#include <cstdint>
+#include <climits>
+#include <type_traits>
+#include <vector>
+
+#include "BitBoard.h"
+#include "Board.h"
+#include "Rng.h"
+
+// Simulated time is whole milliseconds so copies of a game stay bit-identical.
+constexpr int   INITIAL_DELAY_MS = 150;
+constexpr int   MIN_DELAY_MS = 60;
+constexpr int   DELAY_DECREMENT_MS = 8;
+constexpr int   FOODS_PER_LEVEL = 5;
+constexpr int   BONUS_TIME_MS = 5000;
+constexpr int   BONUS_MAX_SCORE = 400;
+constexpr int   ENEMY_MOVE_MS = 200;
+
+constexpr int   MAX_LEVEL = 3;
+const int LEVEL_UP_SCORES[MAX_LEVEL + 1] = { 0, 200, 500, INT_MAX };
+constexpr int STARTING_SNAKE_LENGTH = 3;
+
+// --- shrink arena / warnings ---
+// (fewer on boards too small to keep a playable middle, see maxShrinkTicks())
+constexpr int MAX_SHRINK_TICKS = 5;
+constexpr int SHRINK_FOOD_STEP = (FOODS_PER_LEVEL - 1) * 2;
+constexpr int WARNING_COUNT = 3;
+constexpr int WARNING_INTERVAL_MS = 1000;
+
+// Level-3 swarm capacity on the default board. The largest arena interior is 36x26
+// cells, so half the board is more than a game can ever place; other boards also
+// hold half their cells.
+constexpr int MAX_ENEMIES = WIDTH * HEIGHT / 2;
+
+enum Direction { Up, Down, Left, Right };
+enum PlayMode { PickLevel, CycleLevel };
+
+// Default-board shorthands, for code that only ever sees SnakeSim.
+inline int cellIndex(Cell c) { return DefaultBoard().index(c); }
+inline Cell cellAt(int i) { return DefaultBoard().cell(i); }
+
+using Plane = DefaultBoard::Plane;
+
+// Cells x0..x1, y0..y1 inclusive.
+inline Plane rectPlane(int x0, int x1, int y0, int y1) { return DefaultBoard().rect(x0, x1, y0, y1); }
+
+// Per-Direction head offset; Direction(d ^ 1) is the reverse of d.
+constexpr int DIR_DX[4] = { 0, 0, -1, 1 };
+constexpr int DIR_DY[4] = { -1, 1, 0, 0 };
+
+// Occupancy tags. A cell can carry several at once (e.g. an enemy standing on
+// food), so they are bits rather than an enum; each one is also a bit plane of the
+// whole board (SnakeSim::planes).
+enum CellTag : std::uint8_t {
+    CellSnake = 1u << 0,
+    CellObstacle = 1u << 1,
+    CellEnemy = 1u << 2,
+    CellOuterWall = 1u << 3,
+    CellInnerWall = 1u << 4,   // level-3 shrink ring, only while it is up
+    CellFood = 1u << 5,
+    CellBonus = 1u << 6,
+    CellShrinkFood = 1u << 7,
+};
+constexpr int PLANE_COUNT = 8;
+
+// Snake body as a fixed ring of packed cell indices (y * width + x). Capacity is the
+// whole board, so pushFront/popBack never allocate. Slots grow forwards: the body
+// lives in [tailSlot, headSlot] modulo capacity(), tail first, which is at most two
+// contiguous runs of data().
+template <class B>
+class BasicSnakeBody {
+public:
+    using Index = typename B::Index;
+
+    explicit BasicSnakeBody(const B& b = B())
+        : board(b), cells(b.template cellArray<Index>()), head(b.cells() - 1) {}
+
+    int capacity() const { return int(cells.size()); }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Cell front() const { return unpack(cells[head]); }
+    Cell back() const { return unpack(cells[tailSlot()]); }
+    // i = 0 is the head
+    Cell operator[](int i) const { return unpack(cells[wrap(head - i)]); }
+
+    void pushFront(Cell c) {
+        head = wrap(head + 1);
+        cells[head] = Index(board.index(c));
+        ++count;
+    }
+    void popBack() { --count; }
+    void clear() { count = 0; }
+
+    const Index* data() const { return cells.data(); }
+    int headSlot() const { return head; }
+    int tailSlot() const { return wrap(head - count + 1); }
+
+    class iterator {
+    public:
+        iterator(const BasicSnakeBody* b, int i) : body(b), idx(i) {}
+        Cell operator*() const { return (*body)[idx]; }
+        iterator& operator++() { ++idx; return *this; }
+        bool operator!=(const iterator& o) const { return idx != o.idx; }
+    private:
+        const BasicSnakeBody* body;
+        int idx;
+    };
+    // head to tail
+    iterator begin() const { return { this, 0 }; }
+    iterator end() const { return { this, count }; }
+
+private:
+    int wrap(int i) const { return i < 0 ? i + capacity() : (i >= capacity() ? i - capacity() : i); }
+    Cell unpack(Index i) const { return board.cell(i); }
+
+    B board;
+    typename B::template Cells<Index> cells;
+    int head;
+    int count = 0;
+};
+
+// Level-3 enemies, structure-of-arrays: packed cell index (y * width + x) and the
+// milliseconds since each one last moved. The move kernel walks these flat arrays;
+// who stands where is answered by the CellEnemy grid bits / plane instead.
+// Capacity is half the board.
+template <class B>
+struct BasicEnemySwarm {
+    using Index = typename B::Index;
+
+    explicit BasicEnemySwarm(const B& b = B())
+        : board(b), cell(b.template halfArray<Index>()), timer(b.template halfArray<std::int16_t>()) {}
+
+    B board;
+    typename B::template HalfCells<Index> cell;
+    typename B::template HalfCells<std::int16_t> timer;
+    int count = 0;
+
+    int capacity() const { return int(cell.size()); }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+    Cell pos(int i) const { return board.cell(cell[i]); }
+};
+
+using SnakeBody = BasicSnakeBody<DefaultBoard>;
+using EnemySwarm = BasicEnemySwarm<DefaultBoard>;
+
+// What happened during one step(); the front-end turns these into sound, particles and UI.
+enum SimEvent : unsigned {
+    EvAteFood = 1u << 0,
+    EvAteBonus = 1u << 1,
+    EvAteShrink = 1u << 2,
+    EvLevelUp = 1u << 3,
+    EvDied = 1u << 4,
+    EvWarning = 1u << 5,   // countdown started or ticked down
+    EvShrunk = 1u << 6,
+};
+
+struct StepResult {
+    unsigned events = 0;
+    Cell eatenAt{ -1, -1 };   // cell of the food/bonus eaten this step
+
+    bool has(SimEvent e) const { return (events & e) != 0; }
+};
+
+// One game on board B. All timers run on simulated time: every step() advances the
+// clock by the current `delayMs`, so a game plays identically in the window and
+// headless.
+//
+// On a fixed Board<W,H> the whole game is a single flat, trivially copyable block
+// (no heap members), so snapshot/restore/fork are one memcpy and a fork evolves
+// exactly like the original given the same inputs: tree-search bots can clone it
+// freely. On a DynamicBoard the per-cell arrays live on the heap; copies are still
+// exact, just not a memcpy.
+//
+// Board-size dependent rules: the snake starts a fifth of the way in on the middle
+// row, obstacle counts scale with the board's area (5 / 10 per 40x30), and small
+// boards shrink fewer times. On 40x30 they are the original numbers.
+template <class B>
+struct BasicSnakeSim {
+    using Plane = typename B::Plane;
+    using SnakeBody = BasicSnakeBody<B>;
+    using EnemySwarm = BasicEnemySwarm<B>;
+
+    B board;
+
+    SnakeBody snake;
+    Direction dir = Right;
+    int score = 0;
+    int foodEaten = 0;
+    int delayMs = INITIAL_DELAY_MS;
+    int level = 1;
+    bool gameOver = false;
+
+    Cell food{ -1, -1 };
+    bool bonusActive = false;
+    int bonusMsLeft = 0;
+    Cell bonusFood{ -1, -1 };
+    bool shrinkFoodActive = false;
+    Cell shrinkFood{ -1, -1 };
+
+    EnemySwarm enemies;
+    // Enemies spawned on level 3 (0..enemies.capacity()); kept by newGame() like the level.
+    int swarmSize = 1;
+
+    int shrinkTicks = 0;
+    int nextShrinkFood = SHRINK_FOOD_STEP;
+    bool warningActive = false;
+    int  warningCount = 0;
+    int  warningMs = 0;
+
+    // inner wall ring (level 3); valid after setupLevel()/step()
+    int minX, maxX, minY, maxY;
+
+    // Occupancy, kept in sync with everything above on every change, two ways:
+    // grid[cell] holds the cell's CellTag bits (single-cell lookups are one load)
+    // and planes[k] is the bitboard of tag 1 << k (whole-board work: spawning picks
+    // the n-th set bit of the free plane, shrinking is a mask AND). Obstacles exist
+    // only here.
+    typename B::template Cells<std::uint8_t> grid;
+    std::array<Plane, PLANE_COUNT> planes;
+
+    // Spawn rectangle for food and obstacles: the playfield, or the inside of the
+    // inner ring on level 3. spawnArea is the same rectangle as a mask.
+    int spawnX0, spawnX1, spawnY0, spawnY1;
+    Plane spawnArea;
+
+    // Gameplay randomness (spawns, enemy moves). Nothing else may draw from it, so
+    // the same seed and inputs always give the same game.
+    Rng rng;
+
+    explicit BasicSnakeSim(const B& b = B());
+
+    void seed(std::uint64_t s) { rng.reseed(s); }
+
+    float delaySeconds() const { return delayMs * 0.001f; }
+    float bonusSecondsLeft() const { return bonusMsLeft * 0.001f; }
+
+    BasicSnakeSim fork() const { return *this; }
+    void snapshot(BasicSnakeSim& out) const { out = *this; }
+    void restore(const BasicSnakeSim& from) { *this = from; }
+
+    std::uint8_t at(Cell c) const { return grid[board.index(c)]; }
+    const Plane& plane(CellTag t) const { return planes[bits::lowest(t)]; }
+    const Plane& obstacles() const { return plane(CellObstacle); }
+
+    bool inSpawnArea(Cell c) const {
+        return c.x >= spawnX0 && c.x <= spawnX1 && c.y >= spawnY0 && c.y <= spawnY1;
+    }
+    // Empty cells inside the spawn rectangle.
+    const Plane& freeCells() const { return free; }
+    int freeCellCount() const { return freeCount; }
+
+    // Puts the snake back at the start; keeps level and obstacles (resetGame).
+    void reset();
+    // Builds obstacles, shrink food and enemies for `lvl` (doLevelSetup).
+    void setupLevel(int lvl);
+    // reset() + level selection for a fresh game, as the "New Game" / restart paths do.
+    void newGame(PlayMode mode);
+
+    // Turns the snake unless that would reverse it onto itself.
+    void steer(Direction d);
+    // Where the head goes next tick.
+    Cell nextHead() const { Cell h = snake.front(); return { h.x + DIR_DX[dir], h.y + DIR_DY[dir] }; }
+    // Advances the game by one tick.
+    StepResult step() { return advance(nextHead()); }
+    StepResult step(Direction d) { steer(d); return step(); }
+    // step() with the new head already computed (SnakeBatch does this for many games at once).
+    StepResult advance(Cell head);
+
+private:
+    // t is a single CellTag
+    void tag(Cell c, std::uint8_t t) {
+        int i = board.index(c);
+        grid[i] |= t;
+        planes[bits::lowest(t)].set(i);
+        if (free.test(i)) { free.reset(i); --freeCount; }
+    }
+    void untag(Cell c, std::uint8_t t) {
+        int i = board.index(c);
+        grid[i] &= std::uint8_t(~t);
+        planes[bits::lowest(t)].reset(i);
+        if (grid[i] == 0 && spawnArea.test(i)) { free.set(i); ++freeCount; }
+    }
+    // Makes plane t equal to p, tagging/untagging only the cells that differ.
+    void assignPlane(CellTag t, const Plane& p);
+    // after the spawn area changes
+    void rebuildFree();
+    // Uniform pick among the free cells of the spawn rectangle; {-1,-1} when it is full.
+    Cell randomFreeCell();
+    void placeItem(Cell& slot, Cell p, std::uint8_t t);
+    void clearItem(Cell& slot, std::uint8_t t);
+    void addObstacle(Cell p);
+    // Ring of cells `ticks` in from the outer wall.
+    Plane ringPlane(int ticks) const;
+    int maxShrinkTicks() const;
+    void spawnEnemies(int n);
+    void moveEnemy(int i, int cell);
+    void removeEnemy(int i);
+    void moveEnemies(int dt);
+
+    void updateBounds();
+    void clearObstacles();
+    void generateObstacles(int lvl);
+    void shrinkArena();
+    bool checkLevelUp();
+
+    int innerWallTicks = 0;   // ring currently in planes (0 = none)
+
+    // spawnArea & ~(all planes), and its popcount
+    Plane free;
+    int freeCount = 0;
+};
+
+// The compiled-in boards; anything else runs on DynamicBoard.
+extern template struct BasicSnakeSim<Board<10, 10>>;
+extern template struct BasicSnakeSim<Board<20, 20>>;
+extern template struct BasicSnakeSim<DefaultBoard>;
+extern template struct BasicSnakeSim<Board<64, 64>>;
+extern template struct BasicSnakeSim<DynamicBoard>;
+
+using SnakeSim = BasicSnakeSim<DefaultBoard>;
+using DynamicSnakeSim = BasicSnakeSim<DynamicBoard>;
+
+static_assert(std::is_trivially_copyable<SnakeSim>::value, "SnakeSim must stay memcpy-able for fork()");
+
+// Calls f(board) with the compiled-in Board<w,h> when there is one and a
+// DynamicBoard(w, h) otherwise, so f can be one generic lambda over
+// BasicSnakeSim<decltype(board)> that runs at full speed on the common sizes.
+template <class F>
+auto withBoard(int w, int h, F&& f) -> decltype(f(DefaultBoard())) {
+    if (w == 10 && h == 10) return f(Board<10, 10>());
+    if (w == 20 && h == 20) return f(Board<20, 20>());
+    if (w == WIDTH && h == HEIGHT) return f(DefaultBoard());
+    if (w == 64 && h == 64) return f(Board<64, 64>());
+    return f(DynamicBoard(w, h));
+}
@@ -0,0 +1,6 @@
+#include "SnakeSimImpl.h"
+
+// A translation unit of its own: instantiated next to the fixed boards, the heavier
+// vector-backed code eats GCC's inlining budget and the fixed step loses its inlined
+// tag/untag calls.
+template struct BasicSnakeSim<DynamicBoard>;
@@ -0,0 +1,431 @@
+#pragma once
+
+// BasicSnakeSim member definitions. Only SnakeSim.cpp (the fixed boards) and
+// SnakeSimDynamic.cpp (DynamicBoard) include this; everyone else links against the
+// instantiations SnakeSim.h declares extern.
+
+#include "SnakeSim.h"
+
+#include <algorithm>
+
+template <class B>
+auto BasicSnakeSim<B>::ringPlane(int ticks) const -> Plane {
+    int x0 = ticks + 1, x1 = board.width() - 2 - ticks;
+    int y0 = ticks + 1, y1 = board.height() - 2 - ticks;
+    return board.rect(x0, x1, y0, y1).without(board.rect(x0 + 1, x1 - 1, y0 + 1, y1 - 1));
+}
+
+// The ring may close in until the spawn area inside it is two cells across.
+template <class B>
+int BasicSnakeSim<B>::maxShrinkTicks() const {
+    return std::min(MAX_SHRINK_TICKS, (std::min(board.width(), board.height()) - 6) / 2);
+}
+
+template <class B>
+BasicSnakeSim<B>::BasicSnakeSim(const B& b)
+    : board(b), snake(b), enemies(b),
+      minX(1), maxX(b.width() - 2), minY(1), maxY(b.height() - 2),
+      grid(b.template cellArray<std::uint8_t>()),
+      spawnX0(1), spawnX1(b.width() - 2), spawnY0(1), spawnY1(b.height() - 2),
+      free(b.plane()) {
+    planes.fill(board.plane());
+    spawnArea = board.rect(spawnX0, spawnX1, spawnY0, spawnY1);
+    rebuildFree();
+    assignPlane(CellOuterWall, ringPlane(-1));
+}
+
+template <class B>
+void BasicSnakeSim<B>::rebuildFree() {
+    Plane taken = planes[0];
+    for (int k = 1; k < PLANE_COUNT; ++k) taken |= planes[k];
+    free = spawnArea.without(taken);
+    freeCount = free.count();
+}
+
+template <class B>
+void BasicSnakeSim<B>::assignPlane(CellTag t, const Plane& p) {
+    const Plane cur = plane(t);
+    cur.without(p).forEach([&](int i) { untag(board.cell(i), t); });
+    p.without(cur).forEach([&](int i) { tag(board.cell(i), t); });
+}
+
+template <class B>
+Cell BasicSnakeSim<B>::randomFreeCell() {
+    if (freeCount == 0) return { -1, -1 };
+    return board.cell(free.nth(rng.below(freeCount)));
+}
+
+template <class B>
+void BasicSnakeSim<B>::placeItem(Cell& slot, Cell p, std::uint8_t t) {
+    clearItem(slot, t);
+    slot = p;
+    if (slot.x >= 0) tag(slot, t);
+}
+
+template <class B>
+void BasicSnakeSim<B>::clearItem(Cell& slot, std::uint8_t t) {
+    if (slot.x >= 0) untag(slot, t);
+    slot = { -1, -1 };
+}
+
+template <class B>
+void BasicSnakeSim<B>::addObstacle(Cell p) {
+    if (p.x < 0) return;   // board full
+    tag(p, CellObstacle);
+}
+
+// Spawns up to n enemies on free cells, keeping clear of the snake's head. Move
+// timers are staggered so a big swarm does not all step on the same tick.
+template <class B>
+void BasicSnakeSim<B>::spawnEnemies(int n) {
+    Plane spots = free;
+    if (!snake.empty()) {
+        Cell h = snake.front();
+        spots = spots.without(board.rect(h.x - 2, h.x + 2, h.y - 2, h.y + 2));
+    }
+    int left = spots.count();
+    for (int k = 0; k < n && left > 0 && enemies.count < enemies.capacity(); ++k, --left) {
+        int c = spots.nth(rng.below(left));
+        spots.reset(c);
+        int i = enemies.count++;
+        enemies.cell[i] = typename B::Index(c);
+        enemies.timer[i] = std::int16_t(-(k * ENEMY_MOVE_MS / n));
+        tag(board.cell(c), CellEnemy);
+    }
+}
+
+template <class B>
+void BasicSnakeSim<B>::moveEnemy(int i, int cell) {
+    untag(enemies.pos(i), CellEnemy);
+    enemies.cell[i] = typename B::Index(cell);
+    tag(board.cell(cell), CellEnemy);
+}
+
+// Swaps the last enemy into slot i.
+template <class B>
+void BasicSnakeSim<B>::removeEnemy(int i) {
+    untag(enemies.pos(i), CellEnemy);
+    int last = --enemies.count;
+    enemies.cell[i] = enemies.cell[last];
+    enemies.timer[i] = enemies.timer[last];
+}
+
+// Every enemy whose timer is up steps to a random open neighbour inside the arena.
+// The grid is the spatial index: one byte load per neighbour answers walls,
+// obstacles, the snake and other enemies, so the cost is linear in the swarm.
+template <class B>
+void BasicSnakeSim<B>::moveEnemies(int dt) {
+    const int STEPS[4] = { 1, -1, board.width(), -board.width() };
+    const int n = enemies.count;
+    std::int16_t* timer = enemies.timer.data();
+    for (int i = 0; i < n; ++i) timer[i] = std::int16_t(timer[i] + dt);
+
+    for (int i = 0; i < n; ++i) {
+        if (timer[i] < ENEMY_MOVE_MS) continue;
+        timer[i] = 0;
+
+        const int c = enemies.cell[i];
+        int nbs[4];
+        int k = 0;
+        for (int off : STEPS) {
+            int np = c + off;
+            if (spawnArea.test(np) && !(grid[np] & (CellObstacle | CellSnake | CellEnemy))) nbs[k++] = np;
+        }
+        if (k > 0) moveEnemy(i, nbs[rng.below(k)]);
+    }
+}
+
+template <class B>
+void BasicSnakeSim<B>::reset() {
+    for (Cell c : snake) untag(c, CellSnake);
+    snake.clear();
+    const int x0 = board.width() / 5, y = board.height() / 2;
+    for (int k = 0; k < STARTING_SNAKE_LENGTH; ++k) {
+        Cell c{ x0 + k, y };
+        snake.pushFront(c);
+        tag(c, CellSnake);
+    }
+
+    dir = Right;
+    score = 0;
+    foodEaten = 0;
+    delayMs = INITIAL_DELAY_MS;
+    gameOver = false;
+    warningActive = false;
+    warningCount = 0;
+    warningMs = 0;
+    bonusActive = false;
+    bonusMsLeft = 0;
+    clearItem(bonusFood, CellBonus);
+    clearItem(shrinkFood, CellShrinkFood);
+    placeItem(food, randomFreeCell(), CellFood);
+}
+
+template <class B>
+void BasicSnakeSim<B>::clearObstacles() {
+    assignPlane(CellObstacle, board.plane());
+}
+
+template <class B>
+void BasicSnakeSim<B>::generateObstacles(int lvl) {
+    clearObstacles();
+    // per 40x30 board
+    int count = std::max(1, (lvl == 2 ? 5 : 10) * board.cells() / (WIDTH * HEIGHT));
+    for (int i = 0; i < count; ++i) {
+        addObstacle(randomFreeCell());
+    }
+}
+
+template <class B>
+void BasicSnakeSim<B>::setupLevel(int lvl) {
+    level = lvl;
+    shrinkFoodActive = (lvl == 2 || lvl == 3);
+
+    // enemies only exist on level 3; the arena starts unshrunk there
+    while (!enemies.empty()) removeEnemy(enemies.count - 1);
+    if (lvl == 3) {
+        shrinkTicks = 0;
+        nextShrinkFood = SHRINK_FOOD_STEP;
+        warningActive = false;
+        warningCount = 0;
+        warningMs = 0;
+    }
+    updateBounds();
+
+    if (lvl >= 2) {
+        placeItem(shrinkFood, randomFreeCell(), CellShrinkFood);
+        generateObstacles(lvl);
+    }
+    else {
+        clearObstacles();
+        clearItem(shrinkFood, CellShrinkFood);
+    }
+
+    if (lvl == 3) spawnEnemies(swarmSize);
+}
+
+template <class B>
+void BasicSnakeSim<B>::newGame(PlayMode mode) {
+    // start from an empty board so nothing left over from the previous game (obstacles,
+    // a shrunk arena) can change where the new one spawns things; only the level
+    // choice and the generator carry over
+    // (one set of blanks per fixed board; a dynamic one caches the last size per thread)
+    auto makeBlanks = [](const B& b) {
+        std::vector<BasicSnakeSim> blanks(MAX_LEVEL + 1, BasicSnakeSim(b));
+        for (int l = 1; l <= MAX_LEVEL; ++l) { blanks[l].level = l; blanks[l].updateBounds(); }
+        return blanks;
+    };
+    int lvl = (mode == CycleLevel ? 1 : level);
+    Rng keep = rng;
+    int swarm = swarmSize;
+    if constexpr (B::FIXED) {
+        static const std::vector<BasicSnakeSim> blanks = makeBlanks(board);
+        *this = blanks[lvl];
+    }
+    else {
+        thread_local std::vector<BasicSnakeSim> blanks;
+        if (blanks.empty() || !(blanks[lvl].board == board)) blanks = makeBlanks(board);
+        *this = blanks[lvl];
+    }
+    rng = keep;
+    swarmSize = swarm;
+    level = lvl;
+
+    reset();
+    setupLevel(level);
+}
+
+template <class B>
+void BasicSnakeSim<B>::steer(Direction d) {
+    if (d != Direction(dir ^ 1)) dir = d;
+}
+
+template <class B>
+void BasicSnakeSim<B>::updateBounds() {
+    minX = shrinkTicks + 1; maxX = board.width() - 2 - shrinkTicks;
+    minY = shrinkTicks + 1; maxY = board.height() - 2 - shrinkTicks;
+
+    // the ring only blocks anything on level 3 once the arena has started shrinking
+    int want = (level == 3 ? shrinkTicks : 0);
+    if (want != innerWallTicks) {
+        assignPlane(CellInnerWall, want > 0 ? ringPlane(want) : board.plane());
+        innerWallTicks = want;
+    }
+
+    int x0 = (level == 3 ? minX + 1 : 1), x1 = (level == 3 ? maxX - 1 : board.width() - 2);
+    int y0 = (level == 3 ? minY + 1 : 1), y1 = (level == 3 ? maxY - 1 : board.height() - 2);
+    if (x0 != spawnX0 || x1 != spawnX1 || y0 != spawnY0 || y1 != spawnY1) {
+        spawnX0 = x0; spawnX1 = x1; spawnY0 = y0; spawnY1 = y1;
+        spawnArea = board.rect(x0, x1, y0, y1);
+        rebuildFree();
+    }
+}
+
+template <class B>
+void BasicSnakeSim<B>::shrinkArena() {
+    shrinkTicks++;
+    nextShrinkFood += SHRINK_FOOD_STEP;
+    warningActive = false;
+    updateBounds();
+
+    // enemies caught outside move in; with no room left they are dropped
+    for (int i = 0; i < enemies.count;) {
+        if (spawnArea.test(enemies.cell[i])) { ++i; continue; }
+        Cell dest = randomFreeCell();
+        if (dest.x < 0) { removeEnemy(i); continue; }
+        moveEnemy(i, board.index(dest));
+        ++i;
+    }
+
+    // obstacles outside the new ring go, and as many respawn inside
+    Plane kept = obstacles();
+    int count = kept.count();
+    kept &= board.rect(minX, maxX, minY, maxY);
+    assignPlane(CellObstacle, kept);
+    for (int k = kept.count(); k < count; ++k) {
+        addObstacle(randomFreeCell());
+    }
+
+    // anything left outside the new ring would be unreachable
+    if (food.x >= 0 && !inSpawnArea(food)) placeItem(food, randomFreeCell(), CellFood);
+    if (shrinkFood.x >= 0 && !inSpawnArea(shrinkFood)) placeItem(shrinkFood, randomFreeCell(), CellShrinkFood);
+    if (bonusActive && !inSpawnArea(bonusFood)) placeItem(bonusFood, randomFreeCell(), CellBonus);
+}
+
+template <class B>
+bool BasicSnakeSim<B>::checkLevelUp() {
+    if (level < MAX_LEVEL && score >= LEVEL_UP_SCORES[level]) {
+        level++;
+        setupLevel(level);
+        return true;
+    }
+    return false;
+}
+
+template <class B>
+StepResult BasicSnakeSim<B>::advance(Cell head) {
+    StepResult r;
+    if (gameOver) return r;
+
+    const int dt = delayMs;   // one tick of simulated time
+
+    updateBounds();
+
+    // level 3 enemy movement + collision vs NEW head (FIX)
+    if (level == 3) {
+        moveEnemies(dt);
+
+        if (at(head) & CellEnemy) {
+            gameOver = true;
+            r.events |= EvDied;
+            return r;
+        }
+    }
+
+    // the inner ring is only tagged while it is up, so one mask covers every wall
+    if (at(head) & (CellOuterWall | CellInnerWall | CellSnake | CellObstacle)) {
+        gameOver = true;
+        r.events |= EvDied;
+        return r;
+    }
+
+    // warning countdown -> shrink
+    if (warningActive) {
+        warningMs += dt;
+        if (warningMs >= WARNING_INTERVAL_MS) {
+            warningMs = 0;
+            --warningCount;
+            r.events |= EvWarning;
+            if (warningCount == 0) {
+                shrinkArena();
+                r.events |= EvShrunk;
+            }
+        }
+    }
+
+    snake.pushFront(head);
+    tag(head, CellSnake);
+
+    auto startWarning = [&]() {
+        warningActive = true;
+        warningCount = WARNING_COUNT;
+        warningMs = 0;
+        r.events |= EvWarning;
+    };
+
+    auto popTail = [&]() {
+        untag(snake.back(), CellSnake);
+        snake.popBack();
+    };
+
+    const std::uint8_t here = at(head);
+
+    if (here & CellFood) {
+        score += 10;
+        foodEaten++;
+        r.events |= EvAteFood;
+        r.eatenAt = food;
+
+        if (checkLevelUp()) r.events |= EvLevelUp;
+
+        placeItem(food, randomFreeCell(), CellFood);
+
+        if (level == 2 || level == 3) {
+            placeItem(shrinkFood, randomFreeCell(), CellShrinkFood);
+        }
+
+        if (level == 3 && !warningActive && shrinkTicks < maxShrinkTicks() && foodEaten >= nextShrinkFood) {
+            startWarning();
+        }
+
+        if (foodEaten % FOODS_PER_LEVEL == 0 && !bonusActive) {
+            bonusActive = true;
+            bonusMsLeft = BONUS_TIME_MS;
+            placeItem(bonusFood, randomFreeCell(), CellBonus);
+        }
+
+        delayMs = std::max(MIN_DELAY_MS, delayMs - DELAY_DECREMENT_MS);
+    }
+    else if (bonusActive && (here & CellBonus)) {
+        score += BONUS_MAX_SCORE * bonusMsLeft / BONUS_TIME_MS;
+        bonusActive = false;
+        r.events |= EvAteBonus;
+        r.eatenAt = bonusFood;
+        clearItem(bonusFood, CellBonus);
+
+        if (checkLevelUp()) r.events |= EvLevelUp;
+
+        if (level == 3 && shrinkTicks < maxShrinkTicks() && foodEaten >= nextShrinkFood) {
+            startWarning();
+        }
+    }
+    else if (shrinkFoodActive && (here & CellShrinkFood)) {
+        r.eatenAt = shrinkFood;
+        if (snake.size() <= STARTING_SNAKE_LENGTH + 1) {
+            gameOver = true;
+            r.events |= EvDied | EvAteShrink;
+            return r;
+        }
+        popTail();
+        popTail();
+        score -= 5;
+        r.events |= EvAteShrink;
+
+        placeItem(food, randomFreeCell(), CellFood);
+        if (level == 2 || level == 3) {
+            placeItem(shrinkFood, randomFreeCell(), CellShrinkFood);
+        }
+    }
+    else {
+        popTail();
+    }
+
+    if (bonusActive) {
+        bonusMsLeft -= dt;
+        if (bonusMsLeft <= 0) {
+            bonusActive = false;
+            clearItem(bonusFood, CellBonus);
+        }
+    }
+    return r;
+}
@@ -0,0 +1,115 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+void boxDownsample(const sf::Uint8* src, int stride, int sw, int sh,
+    sf::Uint8* dst, int dw, int dh) {
+    const double fx = double(sw) / dw, fy = double(sh) / dh;
+    for (int y = 0; y < dh; ++y) {
+        const double y0 = y * fy, y1 = (y + 1) * fy;
+        for (int x = 0; x < dw; ++x) {
+            const double x0 = x * fx, x1 = (x + 1) * fx;
+            double r = 0, g = 0, b = 0, a = 0, area = 0;
+            for (int sy = int(y0); sy < std::min(sh, int(std::ceil(y1))); ++sy) {
+                const double wy = std::min(y1, sy + 1.0) - std::max(y0, double(sy));
+                for (int sx = int(x0); sx < std::min(sw, int(std::ceil(x1))); ++sx) {
+                    const double wgt = wy * (std::min(x1, sx + 1.0) - std::max(x0, double(sx)));
+                    const sf::Uint8* p = src + (std::size_t(sy) * std::size_t(stride) + std::size_t(sx)) * 4;
+                    const double wa = wgt * p[3];
+                    r += wa * p[0];
+                    g += wa * p[1];
+                    b += wa * p[2];
+                    a += wa;
+                    area += wgt;
+                }
+            }
+            sf::Uint8* q = dst + (std::size_t(y) * std::size_t(dw) + std::size_t(x)) * 4;
+            if (a > 0) {
+                q[0] = sf::Uint8(r / a + 0.5);
+                q[1] = sf::Uint8(g / a + 0.5);
+                q[2] = sf::Uint8(b / a + 0.5);
+            }
+            else {
+                q[0] = q[1] = q[2] = 0;
+            }
+            q[3] = area > 0 ? sf::Uint8(a / area + 0.5) : 0;
+        }
+    }
+}
+
+int TextureAtlas::add(const sf::Image& src, sf::IntRect area, int w, int h) {
+    const sf::Vector2u size = src.getSize();
+    if (area.width <= 0 || area.height <= 0) area = sf::IntRect(0, 0, int(size.x), int(size.y));
+
+    Entry e;
+    e.w = std::max(w, 1);
+    e.h = std::max(h, 1);
+    e.rgba.assign(std::size_t(e.w) * std::size_t(e.h) * 4, 0);
+    if (const sf::Uint8* px = src.getPixelsPtr()) {
+        const sf::Uint8* origin = px + (std::size_t(area.top) * size.x + std::size_t(area.left)) * 4;
+        boxDownsample(origin, int(size.x), area.width, area.height, e.rgba.data(), e.w, e.h);
+    }
+    entries.push_back(std::move(e));
+    return int(entries.size()) - 1;
+}
+
+int TextureAtlas::addSheet(const sf::Image& src, int cols, int rows, int w, int h) {
+    const int fw = int(src.getSize().x) / cols, fh = int(src.getSize().y) / rows;
+    const int first = int(entries.size());
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < cols; ++c) add(src, sf::IntRect(c * fw, r * fh, fw, fh), w, h);
+    return first;
+}
+
+bool TextureAtlas::build() {
+    if (entries.empty()) return false;
+
+    // shelf packing, tallest first, into the narrowest power-of-two width that keeps
+    // the atlas roughly square
+    std::vector<int> order(entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return entries[a].h > entries[b].h; });
+
+    long long areaSum = 0;
+    int widest = 0;
+    for (const Entry& e : entries) {
+        areaSum += (e.w + 2LL) * (e.h + 2LL);
+        widest = std::max(widest, e.w + 2);
+    }
+    int atlasW = 16;
+    while (atlasW < widest || 1LL * atlasW * atlasW < areaSum) atlasW *= 2;
+
+    int x = 0, y = 0, shelf = 0;
+    for (int id : order) {
+        Entry& e = entries[std::size_t(id)];
+        if (x + e.w + 2 > atlasW) { x = 0; y += shelf; shelf = 0; }
+        e.rect = sf::IntRect(x + 1, y + 1, e.w, e.h);
+        x += e.w + 2;
+        shelf = std::max(shelf, e.h + 2);
+    }
+    int atlasH = 16;
+    while (atlasH < y + shelf) atlasH *= 2;
+
+    std::vector<sf::Uint8> pixels(std::size_t(atlasW) * std::size_t(atlasH) * 4, 0);
+    for (const Entry& e : entries) {
+        // copy with the border pixels repeated one step outwards
+        for (int ty = -1; ty <= e.h; ++ty) {
+            const int sy = std::clamp(ty, 0, e.h - 1);
+            for (int tx = -1; tx <= e.w; ++tx) {
+                const int sx = std::clamp(tx, 0, e.w - 1);
+                const sf::Uint8* p = &e.rgba[(std::size_t(sy) * std::size_t(e.w) + std::size_t(sx)) * 4];
+                sf::Uint8* q = &pixels[(std::size_t(e.rect.top + ty) * std::size_t(atlasW) + std::size_t(e.rect.left + tx)) * 4];
+                std::copy(p, p + 4, q);
+            }
+        }
+    }
+
+    sf::Image img;
+    img.create(unsigned(atlasW), unsigned(atlasH), pixels.data());
+    if (!tex.loadFromImage(img)) return false;
+    tex.setSmooth(true);
+    for (Entry& e : entries) std::vector<sf::Uint8>().swap(e.rgba);
+    return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+// One texture holding every small sprite, each stored at the size it is drawn at.
+// The source images are far bigger than their on-screen cells (800x800 food drawn
+// at 12x12), so add() box-filters each one down once at startup; build() shelf-packs
+// the results with a one-pixel extruded border (so smoothing never picks up a
+// neighbour) and uploads a single texture. Everything drawn from the atlas can then
+// share one texture and batch into one vertex array.
+
+#include <SFML/Graphics.hpp>
+
+#include <vector>
+
+// Area-weighted box filter from an sw x sh RGBA region (row stride `stride` pixels)
+// down to dw x dh. Colour is averaged weighted by alpha, so transparent pixels do
+// not darken the edges of a sprite.
+void boxDownsample(const sf::Uint8* src, int stride, int sw, int sh, sf::Uint8* dst, int dw, int dh);
+
+class TextureAtlas {
+public:
+    // Queues the `area` part of `src` (all of it when empty), downsampled to w x h.
+    // Returns the entry's id; its rectangle is known after build().
+    int add(const sf::Image& src, sf::IntRect area, int w, int h);
+    // Queues a cols x rows sheet of equal frames, each downsampled to w x h; ids are
+    // consecutive, row by row, starting at the returned one.
+    int addSheet(const sf::Image& src, int cols, int rows, int w, int h);
+
+    // Packs the queued entries and uploads the texture; false if that failed.
+    bool build();
+
+    const sf::Texture& texture() const { return tex; }
+    sf::IntRect rect(int id) const { return entries[std::size_t(id)].rect; }
+    sf::FloatRect frect(int id) const { return sf::FloatRect(rect(id)); }
+
+private:
+    struct Entry {
+        std::vector<sf::Uint8> rgba;   // w x h, filled by add()
+        int w = 0, h = 0;
+        sf::IntRect rect;              // placement in the atlas, set by build()
+    };
+
+    std::vector<Entry> entries;
+    sf::Texture tex;
+};